@@ -1,33 +1,16 @@
 #-------------------------------------------------
 #
-# Project created by QtCreator 2014-04-05T10:25:29
+# core  - storage and reminder logic, QtCore and QtSql only
+# app   - the Task List application
+# bench - headless benchmarks for the database layer
 #
 #-------------------------------------------------
 
-QT       += core gui sql
+TEMPLATE = subdirs
 
-CONFIG   += c++11
+SUBDIRS = core \
+    app \
+    bench
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = TaskList
-TEMPLATE = app
-
-
-SOURCES += main.cpp\
-        mainwindow.cpp \
-    tasksdb.cpp \
-    userinputdialog.cpp \
-    taskinputdialog.cpp \
-    reminderdialog.cpp
-
-HEADERS  += mainwindow.h \
-    tasksdb.h \
-    userinputdialog.h \
-    taskinputdialog.h \
-    reminderdialog.h
-
-FORMS    += mainwindow.ui
-
-RESOURCES += \
-    MyResource.qrc
+app.depends = core
+bench.depends = core
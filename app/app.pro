@@ -0,0 +1,39 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2014-04-05T10:25:29
+#
+#-------------------------------------------------
+
+QT       += core gui sql
+
+CONFIG   += c++11
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = TaskList
+TEMPLATE = app
+
+
+include(../core/core.pri)
+
+SOURCES += main.cpp\
+        mainwindow.cpp \
+    userinputdialog.cpp \
+    taskinputdialog.cpp \
+    notificationcenter.cpp \
+    reminderlistmodel.cpp \
+    tasktablemodel.cpp \
+    taskitemdelegate.cpp
+
+HEADERS  += mainwindow.h \
+    userinputdialog.h \
+    taskinputdialog.h \
+    notificationcenter.h \
+    reminderlistmodel.h \
+    tasktablemodel.h \
+    taskitemdelegate.h
+
+FORMS    += mainwindow.ui
+
+RESOURCES += \
+    MyResource.qrc
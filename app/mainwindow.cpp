@@ -0,0 +1,622 @@
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+#include "reminderscheduler.h"
+#include "taskstore.h"
+#include "taskimporter.h"
+#include "notificationcenter.h"
+#include "tasktablemodel.h"
+#include "taskitemdelegate.h"
+#include <QTableView>
+#include <QMenu>
+#include <QAction>
+#include <QContextMenuEvent>
+#include <QHeaderView>
+#include <QSizePolicy>
+#include <QDebug>
+#include <QList>
+#include <QStringList>
+#include <QDateTime>
+#include <QFontMetrics>
+#include <QFont>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
+#include <QDesktopServices>
+#include <QStatusBar>
+#include <QUrl>
+#include <QLineEdit>
+#include <QTimer>
+#include <algorithm>
+
+namespace
+{
+// the most search results shown, the best matches come first
+const int SearchLimit = 1000;
+// the most usernames offered when opening a user
+const int UserSuggestions = 20;
+}
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent), ui(new Ui::MainWindow), currentUser(""),
+      editedTask(-1), searchGeneration(0)
+{
+    ui->setupUi(this);
+
+    // the tasks are kept in memory (see TaskStore), so their writes
+    // can reach the disk a moment later in groups
+    ConnectionOptions options;
+    options.writeBehind = 200;
+    tasksDB = std::unique_ptr<AsyncTasksDB>{ new AsyncTasksDB(QString(),
+                                                              options) };
+    store = new TaskStore(tasksDB.get(), this);
+    scheduler = new ReminderScheduler(store, this);
+    importer = new TaskImporter(tasksDB.get(), this);
+    importProgress = 0;
+    notifications = new NotificationCenter(this);
+    initializeModel();
+    createWidgets();
+    createActions();
+    createMenus();
+    createConnections();
+
+    QApplication::setApplicationName(tr("Task List"));
+
+    // the window is of no use without the database, so this one call
+    // waits for the database thread
+    Result status = tasksDB->status().result();
+    if (!status) {
+        QMessageBox::critical(this, tr("Task List"), status.message);
+        createUserAction->setEnabled(false);
+        openUserAction->setEnabled(false);
+    }
+
+    setWindowTitle(tr("Task List - [*]"));
+
+    setCentralWidget(view);
+
+    resize(840, 560);
+    show();
+}
+
+MainWindow::~MainWindow()
+{
+    // the files of a running import are parsed with the database,
+    // which goes before the child objects
+    delete importer;
+    delete ui;
+}
+
+void MainWindow::initializeModel()
+{
+    model = new TaskTableModel(store, this);
+}
+
+void MainWindow::clearModel()
+{
+    store->clear();
+    QFont font("Verdana", 16);
+    QFontMetrics fm(font);
+    view->setColumnWidth(0, fm.width("Task name") + 50);
+    view->setColumnWidth(1, fm.width("Task description") + 50);
+}
+
+void MainWindow::createWidgets()
+{
+    view = new QTableView(this);
+    view->setModel(model);
+    view->setItemDelegate(new TaskItemDelegate(view));
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->verticalHeader()->hide();
+    QFont font("Verdana", 16);
+    QFontMetrics fm(font);
+    view->setColumnWidth(0, fm.width("Task name") + 50);
+    view->setColumnWidth(1, fm.width("Task description") + 50);
+    view->setStyleSheet("QHeaderView::section {background: lightblue;"
+                        "font-family: Verdana;"
+                        "font-size: 16px;"
+                        "font-weight: bold}");
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    view->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    view->horizontalHeader()->setSortIndicatorShown(true);
+    // the tasks come in deadline order from the store
+    view->horizontalHeader()->setSortIndicator(TaskTableModel::DeadlineColumn,
+                                               Qt::AscendingOrder);
+    view->setSelectionBehavior(QTableView::SelectRows);
+    view->setSortingEnabled(true);
+    view->setAttribute(Qt::WA_DeleteOnClose);
+
+    searchEdit = new QLineEdit(this);
+    searchEdit->setPlaceholderText(tr("Search tasks"));
+    searchEdit->setClearButtonEnabled(true);
+    searchEdit->setMaximumWidth(300);
+    ui->mainToolBar->addWidget(searchEdit);
+    // the search runs once typing pauses
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(150);
+}
+
+void MainWindow::createActions()
+{
+    createUserAction = new QAction(tr("&New User"), this);
+    createUserAction->setShortcut(tr("Ctrl+N"));
+    createUserAction->setStatusTip(tr("New User"));
+
+    openUserAction = new QAction(tr("&Open"), this);
+    openUserAction->setShortcut(tr("Ctrl+O"));
+    openUserAction->setStatusTip(tr("Open User Tasks"));
+
+    addNewTaskAction = new QAction(tr("&Add New Task"), this);
+    addNewTaskAction->setShortcut(tr("Ctrl+T"));
+    addNewTaskAction->setStatusTip(tr("Add New Task"));
+
+    addNewTaskAction->setEnabled(false);
+
+    editTaskAction = new QAction(tr("&Edit"), this);
+    editTaskAction->setShortcut(tr("Ctrl+E"));
+    editTaskAction->setStatusTip(tr("Edit task"));
+
+    editTaskAction->setEnabled(false);
+
+    deleteTaskAction = new QAction(tr("&Delete Task"), this);
+    deleteTaskAction->setShortcut(tr("Ctrl+D"));
+    deleteTaskAction->setStatusTip(tr("Delete Tasks"));
+
+    deleteTaskAction->setEnabled(false);
+
+    sendTaskAction = new QAction(tr("&Send"), this);
+    sendTaskAction->setShortcut(tr("Ctrl+S"));
+    sendTaskAction->setStatusTip(tr("Send Task"));
+
+    sendTaskAction->setEnabled(false);
+
+    exitAction = new QAction(tr("E&xit"), this);
+    exitAction->setShortcut(tr("Ctrl+Q"));
+    exitAction->setStatusTip(tr("Exit"));
+
+    importTaskAction = new QAction(tr("&Import..."), this);
+    importTaskAction->setShortcut(tr("Ctrl+I"));
+    importTaskAction->setStatusTip(tr("Import"));
+
+    importTaskAction->setEnabled(false);
+
+    exportTaskAction = new QAction(tr("&Export..."), this);
+    exportTaskAction->setShortcut(tr("Ctrl+E"));
+    exportTaskAction->setStatusTip(tr("Export"));
+
+    exportTaskAction->setEnabled(false);
+}
+
+void MainWindow::createMenus()
+{
+    fileMenu = menuBar()->addMenu(tr("&File"));
+    toolsMenu = menuBar()->addMenu(tr("&Tools"));
+    toolsMenu->addAction(addNewTaskAction);
+    toolsMenu->addAction(createUserAction);
+    toolsMenu->addAction(openUserAction);
+    fileMenu->addAction(importTaskAction);
+    fileMenu->addAction(exportTaskAction);
+    fileMenu->addSeparator();
+    fileMenu->addAction(exitAction);
+}
+
+void MainWindow::createConnections()
+{
+    connect(addNewTaskAction, SIGNAL(triggered()), this, SLOT(addNewTask()));
+    connect(view, SIGNAL(clicked(QModelIndex)), this,
+            SLOT(editTask(QModelIndex)));
+    connect(deleteTaskAction, SIGNAL(triggered()), this, SLOT(deleteTask()));
+    connect(openUserAction, SIGNAL(triggered()), this, SLOT(openUser()));
+    connect(createUserAction, SIGNAL(triggered()), this, SLOT(createUser()));
+    connect(importTaskAction, SIGNAL(triggered()), this, SLOT(importTask()));
+    connect(exportTaskAction, SIGNAL(triggered()), this, SLOT(exportTask()));
+    connect(exitAction, SIGNAL(triggered()), this, SLOT(close()));
+    connect(sendTaskAction, SIGNAL(triggered()), this, SLOT(sendTask()));
+    connect(scheduler, SIGNAL(due()), this, SLOT(checkReminders()));
+    connect(store, SIGNAL(loadFinished()), this, SLOT(checkReminders()));
+    connect(importer, SIGNAL(finished()), this, SLOT(importFinished()));
+    connect(searchEdit, SIGNAL(textChanged(const QString &)), searchTimer,
+            SLOT(start()));
+    connect(searchTimer, SIGNAL(timeout()), this, SLOT(searchTasks()));
+    // changed tasks may (no longer) match, a reset clears the results
+    connect(store, SIGNAL(reset()), searchTimer, SLOT(start()));
+    connect(store, SIGNAL(loadFinished()), searchTimer, SLOT(start()));
+    connect(store, SIGNAL(taskAdded(qint64)), searchTimer, SLOT(start()));
+    connect(store, SIGNAL(tasksAdded(const QVector<qint64> &)), searchTimer,
+            SLOT(start()));
+    connect(store, SIGNAL(taskChanged(qint64)), searchTimer, SLOT(start()));
+    connect(notifications, SIGNAL(dismiss(const QString &, qint64)), this,
+            SLOT(dismissReminder(const QString &, qint64)));
+    connect(notifications, SIGNAL(snooze(const QString &, qint64, int)), this,
+            SLOT(snoozeReminder(const QString &, qint64, int)));
+    connect(tasksDB.get(), SIGNAL(databaseError(const QString &)), this,
+            SLOT(showDatabaseError(const QString &)));
+}
+
+void MainWindow::importTask()
+{
+    if (currentUser.isEmpty() || importer->isRunning())
+        return;
+    QStringList fileNames = QFileDialog::getOpenFileNames(
+        this, tr("Open Tasks"), "/home",
+        tr("Task files (*.txt *.tasks)") + ";;" + tr("All files (*)"));
+    if (fileNames.isEmpty())
+        return;
+
+    // the files are read in parallel and stored in the database thread
+    // (see TaskImporter), the window stays usable meanwhile
+    importProgress = new QProgressDialog(tr("Importing tasks..."),
+                                         tr("Cancel"), 0, fileNames.size(),
+                                         this);
+    importProgress->setWindowTitle(
+        tr("%1 - Import").arg(QApplication::applicationName()));
+    importProgress->setMinimumDuration(500);
+    connect(importer, SIGNAL(progress(int, int)), importProgress,
+            SLOT(setValue(int)));
+    connect(importProgress, SIGNAL(canceled()), importer, SLOT(cancel()));
+    importer->start(currentUser, fileNames);
+}
+
+void MainWindow::importFinished()
+{
+    importProgress->deleteLater();
+    importProgress = 0;
+
+    // A file is imported completely or not at all. A single file which
+    // was imported needs no summary.
+    QVector<FileImport> files = importer->results();
+    QStringList details;
+    int failed = 0;
+    int skipped = 0;
+    for (const FileImport &file : files) {
+        QString name = QFileInfo(file.fileName).fileName();
+        if (file.cancelled) {
+            skipped++;
+            details << tr("%1: cancelled, nothing was imported.").arg(name);
+        } else if (file.report.errorCount > 0) {
+            failed++;
+            details << tr("%1: %2 problem(s), nothing was imported.")
+                           .arg(name)
+                           .arg(file.report.errorCount);
+            for (const QString &error : file.report.errors)
+                details << "    " + error;
+            if (file.report.errorCount > file.report.errors.size())
+                details << "    " + tr("... and %1 more.")
+                                        .arg(file.report.errorCount -
+                                             file.report.errors.size());
+        } else {
+            details << tr("%1: %2 task(s) imported in %3 ms "
+                          "(%4 tasks/s).")
+                           .arg(name)
+                           .arg(file.report.imported)
+                           .arg(file.report.elapsed)
+                           .arg(file.report.rowsPerSecond());
+        }
+    }
+    if (files.size() > 1 || failed > 0 || skipped > 0) {
+        QMessageBox box(
+            failed > 0 ? QMessageBox::Warning : QMessageBox::Information,
+            tr("%1 - Import").arg(QApplication::applicationName()),
+            tr("Imported %1 task(s) from %2 of %3 file(s).")
+                .arg(importer->imported())
+                .arg(files.size() - failed - skipped)
+                .arg(files.size()),
+            QMessageBox::Ok, this);
+        if (failed > 0)
+            box.setInformativeText(tr("Files with problems were not "
+                                      "imported, please correct them and "
+                                      "try again."));
+        box.setDetailedText(details.join("\n"));
+        box.exec();
+    }
+    // only the imported tasks are read into the store
+    if (importer->user() == store->user()) {
+        for (const FileImport &file : files) {
+            if (file.report.imported > 0)
+                store->fetchTasks(file.report.firstId, file.report.imported);
+        }
+    }
+}
+
+void MainWindow::exportTask()
+{
+    if (currentUser.isEmpty() || model->rowCount() == 0)
+        return;
+    // the binary format is chosen by its filter or file extension
+    QString binaryFilter = tr("Binary task files (*.tasks)");
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(
+        this, tr("%1 - Save User Tasks").arg(QApplication::applicationName()),
+        "/home", tr("Text files (*.txt)") + ";;" + binaryFilter,
+        &selectedFilter);
+    if (fileName.isEmpty())
+        return;
+    TasksDB::FileFormat format =
+        selectedFilter == binaryFilter ||
+                fileName.endsWith(".tasks", Qt::CaseInsensitive)
+            ? TasksDB::BinaryFile
+            : TasksDB::TextFile;
+    whenFinished(tasksDB->exportToFile(currentUser, fileName, format), this,
+                 [this](const Result &result) {
+        if (!result)
+            QMessageBox::warning(this, tr("Task List"), result.message);
+    });
+}
+
+void MainWindow::contextMenuEvent(QContextMenuEvent *event)
+{
+    QMenu menu(this);
+    menu.addAction(addNewTaskAction);
+    menu.addAction(deleteTaskAction);
+    menu.addAction(sendTaskAction);
+    menu.exec(event->globalPos());
+}
+
+void MainWindow::createUser()
+{
+    userDialog =
+        std::unique_ptr<UserInputDialog>{ new UserInputDialog("Create User") };
+    connect(userDialog.get(),
+            SIGNAL(accepted(const QString &, const QString &)), this,
+            SLOT(addUser(const QString &, const QString &)));
+}
+
+void MainWindow::addUser(const QString &name, const QString &username)
+{
+    whenFinished(tasksDB->addNewUser(name, username), this,
+                 [=](const Result &result) { userAdded(username, result); });
+}
+
+void MainWindow::userAdded(const QString &username, const Result &result)
+{
+    if (!result) {
+        QMessageBox::warning(userDialog.get(), tr("Task List"),
+                             result.message);
+        return;
+    }
+    currentUser = username;
+    setWindowTitle(tr("%1 - %2[*]")
+                       .arg(QApplication::applicationName())
+                       .arg(currentUser));
+    view->setVisible(true);
+    addNewTaskAction->setEnabled(true);
+    editTaskAction->setEnabled(true);
+    deleteTaskAction->setEnabled(true);
+    sendTaskAction->setEnabled(true);
+    importTaskAction->setEnabled(true);
+    exportTaskAction->setEnabled(true);
+    loadTasks();
+
+    userDialog->close();
+}
+
+void MainWindow::openUser()
+{
+    userDialog = std::unique_ptr<UserInputDialog>{ new UserInputDialog(
+        "Open user tasks") };
+    connect(userDialog.get(),
+            SIGNAL(accepted(const QString &, const QString &)), this,
+            SLOT(openUserTasks(const QString &, const QString &)));
+    connect(userDialog.get(), SIGNAL(usernameEdited(const QString &)), this,
+            SLOT(suggestUsers(const QString &)));
+}
+
+void MainWindow::suggestUsers(const QString &prefix)
+{
+    // the dialog may have been replaced by the time the names arrive
+    if (prefix.isEmpty())
+        return;
+    UserInputDialog *dialog = userDialog.get();
+    whenFinished(tasksDB->findUsers(prefix, UserSuggestions), this,
+                 [=](const QStringList &usernames) {
+        if (dialog == userDialog.get())
+            dialog->setUsernameSuggestions(prefix, usernames);
+    });
+}
+
+void MainWindow::openUserTasks(const QString &name, const QString &username)
+{
+    whenFinished(tasksDB->hasUser(name, username), this,
+                 [=](const Result &result) { userOpened(username, result); });
+}
+
+void MainWindow::userOpened(const QString &username, const Result &result)
+{
+    if (!result) {
+        QMessageBox::warning(userDialog.get(), tr("Task List"),
+                             result.message);
+        return;
+    }
+    currentUser = username;
+    setWindowTitle(
+        tr("%1 - %2[*]").arg(QApplication::applicationName()).arg(currentUser));
+    addNewTaskAction->setEnabled(true);
+    editTaskAction->setEnabled(true);
+    deleteTaskAction->setEnabled(true);
+    sendTaskAction->setEnabled(true);
+    importTaskAction->setEnabled(true);
+    exportTaskAction->setEnabled(true);
+    loadTasks();
+    userDialog->close();
+}
+
+void MainWindow::loadTasks()
+{
+    // the model and the scheduler follow the store, the reminders are
+    // checked once the tasks have been read
+    clearModel();
+    store->load(currentUser);
+}
+
+void MainWindow::addNewTask()
+{
+    taskDialog = std::unique_ptr<TaskInputDialog>{ new TaskInputDialog };
+    connect(taskDialog.get(),
+            SIGNAL(accepted(const QString &, const QString &, const QString &,
+                            int)),
+            this, SLOT(insertNewTask(const QString &, const QString &,
+                                     const QString &, int)));
+}
+
+void MainWindow::insertNewTask(const QString &taskName, const QString &taskDesc,
+                               const QString &deadline, int remainder)
+{
+    QString created = QString::number(QDateTime::currentMSecsSinceEpoch());
+    Task task;
+    task.name = taskName;
+    task.desc = taskDesc;
+    task.deadline = TasksDB::toEpoch(deadline);
+    task.reminder = remainder;
+    // the row is added once the database has given the task its id
+    whenFinished(store->addTask(task, created), this, [this](qint64 id) {
+        if (id >= 0 && taskDialog)
+            taskDialog->close();
+    });
+}
+
+void MainWindow::editTask(const QModelIndex &index)
+{
+    QModelIndex current = index.isValid() ? index : view->currentIndex();
+    if (!current.isValid())
+        return;
+    editedTask = current.data(TaskTableModel::IdRole).toLongLong();
+    const Task &task = store->task(editedTask);
+    taskDialog = std::unique_ptr<TaskInputDialog>{ new TaskInputDialog };
+    taskDialog->setFields(task.name, task.desc,
+                          TasksDB::fromEpoch(task.deadline), task.reminder);
+    connect(taskDialog.get(),
+            SIGNAL(accepted(const QString &, const QString &, const QString &,
+                            int)),
+            this, SLOT(editNewTask(const QString &, const QString &,
+                                   const QString &, int)));
+}
+
+void MainWindow::editNewTask(const QString &taskName, const QString &taskDesc,
+                             const QString &taskDeadline, int taskRemainder)
+{
+    // the task may have been removed (or reloaded away) meanwhile
+    if (!store->contains(editedTask)) {
+        taskDialog->close();
+        return;
+    }
+    Task task = store->task(editedTask);
+    task.name = taskName;
+    task.desc = taskDesc;
+    task.deadline = TasksDB::toEpoch(taskDeadline);
+    task.reminder = taskRemainder;
+    store->updateTask(task);
+    taskDialog->close();
+    checkReminders();
+}
+
+void MainWindow::deleteTask()
+{
+    int row = view->currentIndex().row();
+    if (row >= 0 && row < model->rowCount())
+        store->removeTask(model->task(row).id);
+}
+
+void MainWindow::sendTask()
+{
+    // when sending a task to a another user, first task is stored to a file
+    // and then (default)email-client is opened. The client's subject and boby
+    // fields are filled automatically but for some reason (probably due to
+    // security)
+    // it(thunderbird) refuses to attach the task file.
+    int row = view->currentIndex().row();
+    if (row < 0 || row >= model->rowCount())
+        return;
+    QString fileName = QFileDialog::getSaveFileName(
+        this, tr("%1 - Save Task").arg(QApplication::applicationName()),
+        "/home", tr("Text files (*.txt)"));
+    if (fileName.isEmpty())
+        return;
+    const Task &task = model->task(row);
+    QString taskName = task.name;
+    whenFinished(tasksDB->exportTask(currentUser, task.id, fileName), this,
+                 [=](const Result &result) {
+        if (!result) {
+            QMessageBox::warning(this, tr("Task List"), result.message);
+            return;
+        }
+        QDesktopServices::openUrl(QUrl("mailto:?subject=Task: " +
+                                       taskName.toHtmlEscaped() +
+                                       "&body=See attachment"));
+    });
+}
+
+void MainWindow::checkReminders()
+{
+    // ReminderScheduler triggers this method whenever a reminder or
+    // a snooze of some task is due or a reminded task turns over due
+    // (and it's run once the tasks of a user have been loaded). It'll
+    // check possible reminders, snoozed tasks, tasks which are over
+    // due and pending tasks. The check runs on the tasks in memory.
+    if (currentUser.isEmpty() || !store->isLoaded())
+        return;
+    ReminderCheck check = store->checkReminders();
+    // deadlines which have just passed are painted red
+    view->viewport()->update();
+    showReminders(check.due + check.snoozed + check.overdue + check.pending);
+}
+
+void MainWindow::searchTasks()
+{
+    // The search runs in the database thread, results of an older
+    // search which arrive after a newer one was started are dropped.
+    int search = ++searchGeneration;
+    QString text = searchEdit->text().trimmed();
+    if (text.isEmpty() || currentUser.isEmpty() || !store->isLoaded()) {
+        model->clearFilter();
+        // the rows are in the store's order again (a reset of the
+        // store also ends the filter)
+        if (view->horizontalHeader()->sortIndicatorSection() < 0)
+            view->horizontalHeader()->setSortIndicator(
+                TaskTableModel::DeadlineColumn, Qt::AscendingOrder);
+        return;
+    }
+    // the results come ranked by relevance, the sort indicator is
+    // cleared until the user sorts them by a column
+    whenFinished(tasksDB->searchTasks(currentUser, text, SearchLimit), this,
+                 [=](const QVector<qint64> &ids) {
+        if (search != searchGeneration)
+            return;
+        model->setFilter(ids);
+        view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    });
+}
+
+void MainWindow::showReminders(const QVector<Reminder> &reminders)
+{
+    // reminders which are already listed are updated in place
+    if (!reminders.isEmpty())
+        notifications->addReminders(currentUser, reminders);
+}
+
+void MainWindow::showDatabaseError(const QString &message)
+{
+    statusBar()->showMessage(tr("Database error: %1").arg(message), 5000);
+}
+
+void MainWindow::dismissReminder(const QString &username, qint64 id)
+{
+    // the reminders of a user who is no longer open go to the database
+    if (username == store->user())
+        store->dismissReminder(id);
+    else
+        tasksDB->dismissReminder(username, id);
+}
+
+void MainWindow::snoozeReminder(const QString &username, qint64 id,
+                                int snoozed)
+{
+    QString snoozeCreated =
+        QDateTime::currentDateTime().toString("d.M.yyyy hh.mm");
+    if (username == store->user())
+        store->snoozeTask(id, snoozed, snoozeCreated);
+    else
+        tasksDB->setSnoozeForTask(username, id, snoozed, snoozeCreated);
+}
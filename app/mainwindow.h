@@ -6,9 +6,8 @@
 #include <QModelIndex>
 #include <QVector>
 #include "userinputdialog.h"
-#include "tasksdb.h"
+#include "asynctasksdb.h"
 #include "taskinputdialog.h"
-#include "reminderdialog.h"
 
 namespace Ui
 {
@@ -18,8 +17,14 @@ class MainWindow;
 class QMenu;
 class QAction;
 class QTableView;
-class QStandardItemModel;
+class TaskTableModel;
 class QContextMenuEvent;
+class ReminderScheduler;
+class TaskStore;
+class TaskImporter;
+class NotificationCenter;
+class QProgressDialog;
+class QLineEdit;
 class QTimer;
 
 class MainWindow : public QMainWindow
@@ -38,22 +43,24 @@ signals:
   private
 slots:
     void importTask();
+    void importFinished();
     void exportTask();
     void createUser();
     void openUser();
     void openUserTasks(const QString &, const QString &);
+    void suggestUsers(const QString &);
     void addUser(const QString &, const QString &);
     void addNewTask();
-    void insertNewTask(const QString &, const QString &, const QString &,
-                       const QString &);
+    void insertNewTask(const QString &, const QString &, const QString &, int);
     void editTask(const QModelIndex &index = QModelIndex());
-    void editNewTask(const QString &, const QString &, const QString &,
-                     const QString &);
+    void editNewTask(const QString &, const QString &, const QString &, int);
     void deleteTask();
     void sendTask();
     void checkReminders();
-    void dismissReminder(const QString &, const QString &);
-    void snoozeReminder(const QString &, const QString &, const QString &);
+    void searchTasks();
+    void dismissReminder(const QString &, qint64);
+    void snoozeReminder(const QString &, qint64, int);
+    void showDatabaseError(const QString &);
 
   private:
     Ui::MainWindow *ui;
@@ -64,6 +71,10 @@ slots:
     void createMenus();
     void createConnections();
     void clearModel();
+    void loadTasks();
+    void userAdded(const QString &, const Result &);
+    void userOpened(const QString &, const Result &);
+    void showReminders(const QVector<Reminder> &);
 
     QMenu *fileMenu;
     QMenu *toolsMenu;
@@ -79,15 +90,24 @@ slots:
     QAction *exportTaskAction;
 
     QTableView *view;
-    QStandardItemModel *model;
+    TaskTableModel *model;
     QString currentUser;
     std::unique_ptr<TaskInputDialog> taskDialog;
     std::unique_ptr<UserInputDialog> userDialog;
-    std::unique_ptr<TasksDB> tasksDB;
-    std::unique_ptr<ReminderDialog> reminderDialog;
-    QVector<std::shared_ptr<ReminderDialog> > dialogs;
-    QModelIndex currentIndex;
-    QTimer *timerForRem;
+    std::unique_ptr<AsyncTasksDB> tasksDB;
+    // the id of the task in the edit dialog, the rows of the view may
+    // change while the dialog is open
+    qint64 editedTask;
+    TaskStore *store;
+    ReminderScheduler *scheduler;
+    TaskImporter *importer;
+    // shown while the importer runs
+    QProgressDialog *importProgress;
+    NotificationCenter *notifications;
+    QLineEdit *searchEdit;
+    QTimer *searchTimer;
+    // drops the results of outdated searches
+    int searchGeneration;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,214 @@
+#include "notificationcenter.h"
+#include "reminderlistmodel.h"
+#include "tasksdb.h"
+#include <QApplication>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QComboBox>
+#include <QTableView>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QDateTime>
+#include <QStringList>
+#include <QTimer>
+#include <QPixmap>
+#include <QShowEvent>
+#include <QHideEvent>
+
+namespace
+{
+// a snooze can only be chosen when more than this is left, see
+// NotificationCenter::snoozeChoices
+const qint64 SnoozeLimits[] = { 15 * 60, 30 * 60, 3600, 2 * 3600, 4 * 3600 };
+}
+
+NotificationCenter::NotificationCenter(QWidget *parent) : QDialog(parent)
+{
+    model = new ReminderListModel(this);
+    timer = new QTimer(this);
+    timer->setInterval(1000 * 60);
+    createWidgets();
+    createLayout();
+    createConnections();
+
+    setWindowTitle(tr("Reminders - ") + QApplication::applicationName());
+    resize(560, 320);
+}
+
+void NotificationCenter::addReminders(const QString &username,
+                                      const QVector<Reminder> &reminders)
+{
+    // an open window is not brought to the front again
+    if (model->addReminders(username, reminders) == 0 || isVisible())
+        return;
+    show();
+    raise();
+}
+
+int NotificationCenter::count() const
+{
+    return model->rowCount();
+}
+
+void NotificationCenter::showEvent(QShowEvent *event)
+{
+    populateCombobox();
+    timer->start();
+    QDialog::showEvent(event);
+}
+
+void NotificationCenter::hideEvent(QHideEvent *event)
+{
+    timer->stop();
+    QDialog::hideEvent(event);
+}
+
+void NotificationCenter::createWidgets()
+{
+    iconLabel = new QLabel(this);
+    QPixmap icon(":/images/Information-icon.png");
+    setWindowIcon(icon);
+    iconLabel->setPixmap(icon);
+    summaryLabel = new QLabel(this);
+    view = new QTableView(this);
+    view->setModel(model);
+    view->setSelectionBehavior(QTableView::SelectRows);
+    view->setSelectionMode(QTableView::ExtendedSelection);
+    view->verticalHeader()->hide();
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    view->setColumnWidth(ReminderListModel::NameColumn, 200);
+    view->setColumnWidth(ReminderListModel::DeadlineColumn, 150);
+    snoozeBox = new QComboBox(this);
+    dismissButton = new QPushButton(tr("Dismiss"), this);
+    dismissAllButton = new QPushButton(tr("Dismiss All"), this);
+    snoozeButton = new QPushButton(tr("Snooze"), this);
+    updateSummary();
+}
+
+void NotificationCenter::createLayout()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *layoutForIcon = new QHBoxLayout;
+    layoutForIcon->addWidget(iconLabel);
+    layoutForIcon->addWidget(summaryLabel, 1);
+    mainLayout->addLayout(layoutForIcon);
+    mainLayout->addWidget(view);
+    QHBoxLayout *layoutForButtons = new QHBoxLayout;
+    layoutForButtons->addWidget(snoozeBox);
+    snoozeBox->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+    layoutForButtons->addWidget(snoozeButton);
+    layoutForButtons->addWidget(dismissButton);
+    layoutForButtons->addWidget(dismissAllButton);
+    mainLayout->addLayout(layoutForButtons);
+    setLayout(mainLayout);
+}
+
+void NotificationCenter::createConnections()
+{
+    connect(dismissButton, SIGNAL(clicked()), this, SLOT(dismissSelected()));
+    connect(dismissAllButton, SIGNAL(clicked()), this, SLOT(dismissAll()));
+    connect(snoozeButton, SIGNAL(clicked()), this, SLOT(snoozeSelected()));
+    connect(timer, SIGNAL(timeout()), this, SLOT(populateCombobox()));
+    connect(view->selectionModel(),
+            SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this,
+            SLOT(populateCombobox()));
+    connect(model, SIGNAL(rowsInserted(QModelIndex, int, int)), this,
+            SLOT(updateSummary()));
+    connect(model, SIGNAL(rowsRemoved(QModelIndex, int, int)), this,
+            SLOT(updateSummary()));
+}
+
+void NotificationCenter::dismissSelected()
+{
+    QVector<int> rows = selectedRows();
+    for (int row : rows)
+        emit dismiss(model->user(row), model->reminder(row).id);
+    model->removeReminders(rows);
+    if (count() == 0)
+        hide();
+}
+
+void NotificationCenter::dismissAll()
+{
+    view->selectAll();
+    dismissSelected();
+}
+
+void NotificationCenter::snoozeSelected()
+{
+    if (snoozeBox->currentText().isEmpty())
+        return;
+    int snoozed = TasksDB::snoozeCode(snoozeBox->currentText());
+    QVector<int> rows = selectedRows();
+    for (int row : rows)
+        emit snooze(model->user(row), model->reminder(row).id, snoozed);
+    model->removeReminders(rows);
+    if (count() == 0)
+        hide();
+}
+
+void NotificationCenter::populateCombobox()
+{
+    // The choices fit the selected task which starts first, so the
+    // snooze works for all of them. This runs on selection changes
+    // and once a minute, as the choices shrink with the time left.
+    QVector<int> rows = selectedRows();
+    qint64 deadline = 0;
+    for (int row : rows) {
+        qint64 start = model->reminder(row).deadline;
+        if (deadline == 0 || start < deadline)
+            deadline = start;
+    }
+    QStringList choices;
+    if (!rows.isEmpty())
+        choices = snoozeChoices(
+            deadline, QDateTime::currentMSecsSinceEpoch() / 1000);
+    QString current = snoozeBox->currentText();
+    snoozeBox->clear();
+    snoozeBox->addItems(choices);
+    if (choices.contains(current))
+        snoozeBox->setCurrentText(current);
+    dismissButton->setEnabled(!rows.isEmpty());
+    snoozeButton->setEnabled(!choices.isEmpty());
+}
+
+void NotificationCenter::updateSummary()
+{
+    summaryLabel->setText(
+        tr("<b><font color = '#006699'>%1 active reminder(s)</font></b>")
+            .arg(count()));
+    dismissAllButton->setEnabled(count() > 0);
+}
+
+QVector<int> NotificationCenter::selectedRows() const
+{
+    QVector<int> rows;
+    for (const QModelIndex &index : view->selectionModel()->selectedRows())
+        rows.append(index.row());
+    return rows;
+}
+
+QStringList NotificationCenter::snoozeChoices(qint64 deadline,
+                                              qint64 currentTime)
+{
+    // A snooze has to wake up before the task starts, so the less time
+    // is left the fewer choices there are: none in the last 5 minutes,
+    // then "5 mins before start" and "5 mins", from 10 minutes on the
+    // first four and one more for each limit passed.
+    qint64 left = deadline - currentTime;
+    QStringList labels = TasksDB::snoozeLabels();
+    if (left <= 5 * 60)
+        return QStringList();
+    if (left <= 10 * 60)
+        return QStringList() << labels.at(TasksDB::S_5MINSBEFORESTART)
+                             << labels.at(TasksDB::S_5MINS);
+    int choices = 4;
+    for (qint64 limit : SnoozeLimits) {
+        if (left > limit)
+            choices++;
+    }
+    return labels.mid(0, choices);
+}
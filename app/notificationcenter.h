@@ -0,0 +1,73 @@
+/**
+  * One window for all active reminders, replacing a
+  * dialog per reminder. The reminders are listed in a
+  * ReminderListModel and the selected ones can be dismissed
+  * or snoozed together. A single timer refreshes the snooze
+  * choices while the window is shown.
+  *
+**/
+
+#ifndef NOTIFICATIONCENTER_H
+#define NOTIFICATIONCENTER_H
+
+#include <QDialog>
+#include <QVector>
+#include "task.h"
+
+class QLabel;
+class QComboBox;
+class QPushButton;
+class QTableView;
+class QTimer;
+class QShowEvent;
+class QHideEvent;
+class ReminderListModel;
+
+class NotificationCenter : public QDialog
+{
+    Q_OBJECT
+  public:
+    explicit NotificationCenter(QWidget *parent = 0);
+
+    // lists the reminders of a check, the window is shown when there
+    // are new ones
+    void addReminders(const QString &, const QVector<Reminder> &);
+    int count() const;
+
+  protected:
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+
+  signals:
+    void dismiss(const QString &, qint64);
+    void snooze(const QString &, qint64, int);
+
+  private slots:
+    void dismissSelected();
+    void dismissAll();
+    void snoozeSelected();
+    void populateCombobox();
+    void updateSummary();
+
+  private:
+    void createWidgets();
+    void createLayout();
+    void createConnections();
+    QVector<int> selectedRows() const;
+    static QStringList snoozeChoices(qint64, qint64);
+
+    QLabel *iconLabel;
+    QLabel *summaryLabel;
+    QTableView *view;
+    ReminderListModel *model;
+    QComboBox *snoozeBox;
+    QPushButton *dismissButton;
+    QPushButton *dismissAllButton;
+    QPushButton *snoozeButton;
+    // refreshes the snooze choices every minute while shown
+    QTimer *timer;
+
+    Q_DISABLE_COPY(NotificationCenter)
+};
+
+#endif // NOTIFICATIONCENTER_H
@@ -0,0 +1,117 @@
+#include "reminderlistmodel.h"
+#include "tasksdb.h"
+#include <algorithm>
+
+ReminderListModel::ReminderListModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ReminderListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : entries.size();
+}
+
+int ReminderListModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ReminderListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= entries.size() ||
+        role != Qt::DisplayRole)
+        return QVariant();
+    const Reminder &reminder = entries.at(index.row()).reminder;
+    switch (index.column()) {
+    case NameColumn:
+        return reminder.name;
+    case DeadlineColumn:
+        return TasksDB::fromEpoch(reminder.deadline);
+    case DueInColumn:
+        return reminder.dueIn;
+    }
+    return QVariant();
+}
+
+QVariant ReminderListModel::headerData(int section,
+                                       Qt::Orientation orientation,
+                                       int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+    switch (section) {
+    case NameColumn:
+        return tr("Task name");
+    case DeadlineColumn:
+        return tr("Start time");
+    case DueInColumn:
+        return tr("Due in");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ReminderListModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+int ReminderListModel::addReminders(const QString &username,
+                                    const QVector<Reminder> &reminders)
+{
+    // the listed reminders are updated, the new ones appended in one go
+    QVector<Entry> added;
+    for (const Reminder &reminder : reminders) {
+        int row = find(username, reminder.id);
+        if (row < 0) {
+            added.append(Entry{ username, reminder });
+            continue;
+        }
+        entries[row].reminder = reminder;
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    }
+    if (!added.isEmpty()) {
+        beginInsertRows(QModelIndex(), entries.size(),
+                        entries.size() + added.size() - 1);
+        entries += added;
+        endInsertRows();
+    }
+    return added.size();
+}
+
+const Reminder &ReminderListModel::reminder(int row) const
+{
+    return entries.at(row).reminder;
+}
+
+QString ReminderListModel::user(int row) const
+{
+    return entries.at(row).username;
+}
+
+void ReminderListModel::removeReminders(QVector<int> rows)
+{
+    // from the last row up so that the other rows keep their numbers
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    for (int i = rows.size() - 1; i >= 0; i--) {
+        int row = rows.at(i);
+        if (row < 0 || row >= entries.size())
+            continue;
+        beginRemoveRows(QModelIndex(), row, row);
+        entries.remove(row);
+        endRemoveRows();
+    }
+}
+
+int ReminderListModel::find(const QString &username, qint64 id) const
+{
+    for (int row = 0; row < entries.size(); row++) {
+        if (entries.at(row).reminder.id == id &&
+            entries.at(row).username == username)
+            return row;
+    }
+    return -1;
+}
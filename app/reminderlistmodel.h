@@ -0,0 +1,52 @@
+/**
+  * This model holds the active reminders shown in the
+  * notification center. A reminder stays until it is
+  * dismissed or snoozed; when a later check reports the
+  * same task again its row is updated in place instead of
+  * adding another one. Reminders of several users can be
+  * listed, each row remembers the user it belongs to.
+  *
+**/
+
+#ifndef REMINDERLISTMODEL_H
+#define REMINDERLISTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include "task.h"
+
+class ReminderListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+  public:
+    enum Columns { NameColumn, DeadlineColumn, DueInColumn, ColumnCount };
+
+    explicit ReminderListModel(QObject *parent = 0);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const;
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+
+    // returns the number of reminders which were not listed yet
+    int addReminders(const QString &, const QVector<Reminder> &);
+    const Reminder &reminder(int row) const;
+    QString user(int row) const;
+    // the rows may be given in any order
+    void removeReminders(QVector<int>);
+
+  private:
+    struct Entry
+    {
+        QString username;
+        Reminder reminder;
+    };
+
+    int find(const QString &, qint64) const;
+
+    QVector<Entry> entries;
+};
+
+#endif // REMINDERLISTMODEL_H
@@ -1,4 +1,5 @@
 #include "taskinputdialog.h"
+#include "tasksdb.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -50,12 +51,9 @@ void TaskInputDialog::createWidgets()
     taskDeadlineTimeEdit = new QTimeEdit(this);
     taskRemainderLabel = new QLabel(tr("Choose a reminder for the task:"));
     remainderBox = new QComboBox(this);
-    remainderBox->insertItem(0, "1 day");
-    remainderBox->insertItem(1, "2 hrs");
-    remainderBox->insertItem(2, "1 hr");
-    remainderBox->insertItem(3, "30 mins");
-    remainderBox->insertItem(4, "10 mins");
-    remainderBox->insertItem(5, "no reminder");
+    // the items carry the reminder codes, the labels are only shown
+    for (const QString &label : TasksDB::reminderLabels())
+        remainderBox->addItem(label, TasksDB::reminderCode(label));
 }
 
 void TaskInputDialog::createLayout()
@@ -92,13 +90,13 @@ void TaskInputDialog::acceptInput()
     QString deadline =
         taskDeadlineDateEdit->text() + " " + taskDeadlineTimeEdit->text();
     emit accepted(taskNameEdit->text(), taskDescEdit->text(), deadline,
-                  remainderBox->currentText());
+                  remainderBox->currentData().toInt());
 }
 
 void TaskInputDialog::setFields(const QString &taskName,
                                 const QString &taskDesc,
                                 const QString &deadline,
-                                const QString &remainder)
+                                int remainder)
 {
     taskNameEdit->setText(taskName);
     taskDescEdit->setText(taskDesc);
@@ -108,6 +106,6 @@ void TaskInputDialog::setFields(const QString &taskName,
     time = time.mid(time.indexOf(" ") + 1);
     taskDeadlineDateEdit->setDate(QDate::fromString(date, "d.M.yyyy"));
     taskDeadlineTimeEdit->setTime(QTime::fromString(time, "hh.mm"));
-    remainderBox->setCurrentIndex(remainderBox->findText(remainder));
+    remainderBox->setCurrentIndex(remainderBox->findData(remainder));
     taskNameEdit->setFocus();
 }
@@ -19,15 +19,13 @@ class TaskInputDialog : public QDialog
     Q_OBJECT
   public:
     explicit TaskInputDialog(QWidget *parent = 0);
-    void setFields(const QString &, const QString &, const QString &,
-                   const QString &);
+    void setFields(const QString &, const QString &, const QString &, int);
 
   protected:
     void closeEvent(QCloseEvent *event);
 
   signals:
-    void accepted(const QString &, const QString &, const QString &,
-                  const QString &);
+    void accepted(const QString &, const QString &, const QString &, int);
 
   private slots:
     void acceptInput();
@@ -0,0 +1,27 @@
+#include "taskitemdelegate.h"
+#include "tasktablemodel.h"
+#include <QDateTime>
+
+TaskItemDelegate::TaskItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent), font("Verdana", 10),
+      deadlineFont("Verdana", 10, QFont::Bold), fontMetrics(font),
+      deadlineFontMetrics(deadlineFont), stripeBrush(QColor(135, 206, 250)),
+      overdueBrush(QColor(255, 0, 0))
+{
+}
+
+void TaskItemDelegate::initStyleOption(QStyleOptionViewItem *option,
+                                       const QModelIndex &index) const
+{
+    // used for painting and for the size hints, the stripes follow the
+    // row number so they stay even after rows are removed or sorted
+    QStyledItemDelegate::initStyleOption(option, index);
+    bool deadline = index.column() == TaskTableModel::DeadlineColumn;
+    option->font = deadline ? deadlineFont : font;
+    option->fontMetrics = deadline ? deadlineFontMetrics : fontMetrics;
+    if (deadline && index.data(TaskTableModel::DeadlineRole).toLongLong() <
+                        QDateTime::currentMSecsSinceEpoch() / 1000)
+        option->backgroundBrush = overdueBrush;
+    else if (index.row() % 2)
+        option->backgroundBrush = stripeBrush;
+}
@@ -0,0 +1,38 @@
+/**
+  * This delegate styles the rows of the task table: stripes
+  * on every other row, a bold deadline and a red background
+  * for deadlines which have passed. The fonts and brushes
+  * are created once and shared by all rows, and the overdue
+  * state is worked out from the deadline (see
+  * TaskTableModel::DeadlineRole) only when a row is painted.
+  *
+**/
+
+#ifndef TASKITEMDELEGATE_H
+#define TASKITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QBrush>
+#include <QFont>
+#include <QFontMetrics>
+
+class TaskItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+  public:
+    explicit TaskItemDelegate(QObject *parent = 0);
+
+  protected:
+    void initStyleOption(QStyleOptionViewItem *option,
+                         const QModelIndex &index) const;
+
+  private:
+    QFont font;
+    QFont deadlineFont;
+    QFontMetrics fontMetrics;
+    QFontMetrics deadlineFontMetrics;
+    QBrush stripeBrush;
+    QBrush overdueBrush;
+};
+
+#endif // TASKITEMDELEGATE_H
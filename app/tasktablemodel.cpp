@@ -0,0 +1,300 @@
+#include "tasktablemodel.h"
+#include "taskstore.h"
+#include "tasksdb.h"
+#include <QPair>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+template <typename Less>
+void sortRows(QVector<int> &sorted, Qt::SortOrder order, Less less)
+{
+    if (order == Qt::AscendingOrder)
+        std::stable_sort(sorted.begin(), sorted.end(), less);
+    else
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [&less](int a, int b) { return less(b, a); });
+}
+}
+
+TaskTableModel::TaskTableModel(TaskStore *store, QObject *parent)
+    : QAbstractTableModel(parent), store(store), rowIndexValid(false),
+      filtered(false),
+      sortColumn(DeadlineColumn), sortOrder(Qt::AscendingOrder)
+{
+    connect(store, SIGNAL(reset()), this, SLOT(reset()));
+    connect(store, SIGNAL(taskAdded(qint64)), this, SLOT(taskAdded(qint64)));
+    connect(store, SIGNAL(tasksAdded(const QVector<qint64> &)), this,
+            SLOT(tasksAdded(const QVector<qint64> &)));
+    connect(store, SIGNAL(taskChanged(qint64)), this,
+            SLOT(taskChanged(qint64)));
+    connect(store, SIGNAL(taskRemoved(qint64)), this,
+            SLOT(taskRemoved(qint64)));
+}
+
+int TaskTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rows.size();
+}
+
+int TaskTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TaskTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+    const Task &task = store->task(rows.at(index.row()));
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case NameColumn:
+            return task.name;
+        case DescColumn:
+            return task.desc;
+        case DeadlineColumn:
+            return TasksDB::fromEpoch(task.deadline);
+        }
+        break;
+    case IdRole:
+        return task.id;
+    case DeadlineRole:
+        return task.deadline;
+    }
+    return QVariant();
+}
+
+QVariant TaskTableModel::headerData(int section, Qt::Orientation orientation,
+                                    int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+    switch (section) {
+    case NameColumn:
+        return tr("Task name");
+    case DescColumn:
+        return tr("Task description");
+    case DeadlineColumn:
+        return tr("Deadline");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags TaskTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+void TaskTableModel::sort(int column, Qt::SortOrder order)
+{
+    // Rows are sorted through a permutation so that the persistent
+    // indexes (e.g. the selection) can follow their tasks. The sort is
+    // kept and applied to the rows of later resets and added tasks
+    // too. No column (a cleared sort indicator) leaves the order of a
+    // filter alone.
+    sortColumn = column;
+    sortOrder = column < 0 ? Qt::AscendingOrder : order;
+    if (column < 0 && filtered)
+        return;
+    reorder(sortPermutation(rows));
+}
+
+void TaskTableModel::reorder(const QVector<int> &sorted)
+{
+    emit layoutAboutToBeChanged();
+    QVector<qint64> sortedRows;
+    sortedRows.reserve(rows.size());
+    QVector<int> newRows(rows.size());
+    for (int i = 0; i < sorted.size(); i++) {
+        sortedRows.append(rows.at(sorted.at(i)));
+        newRows[sorted.at(i)] = i;
+    }
+    rows = sortedRows;
+    rowIndexValid = false;
+    QModelIndexList from = persistentIndexList();
+    QModelIndexList to;
+    for (const auto &old : from)
+        to.append(index(newRows.at(old.row()), old.column()));
+    changePersistentIndexList(from, to);
+    emit layoutChanged();
+}
+
+const Task &TaskTableModel::task(int row) const
+{
+    return store->task(rows.at(row));
+}
+
+void TaskTableModel::setFilter(const QVector<qint64> &ids)
+{
+    QVector<qint64> shown;
+    shown.reserve(ids.size());
+    for (qint64 id : ids) {
+        if (store->contains(id))
+            shown.append(id);
+    }
+    // the owner clears the sort indicator of the view, see
+    // MainWindow::searchTasks
+    beginResetModel();
+    rows = shown;
+    rowIndexValid = false;
+    filtered = true;
+    sortColumn = -1;
+    sortOrder = Qt::AscendingOrder;
+    endResetModel();
+}
+
+void TaskTableModel::clearFilter()
+{
+    if (filtered)
+        reset();
+}
+
+bool TaskTableModel::isFiltered() const
+{
+    return filtered;
+}
+
+void TaskTableModel::reset()
+{
+    // the store gives the tasks in ascending deadline order
+    QVector<qint64> ids = store->ids();
+    if (sortColumn == NameColumn || sortColumn == DescColumn ||
+        sortOrder != Qt::AscendingOrder)
+        ids = inSortOrder(ids);
+    beginResetModel();
+    rows = ids;
+    rowIndexValid = false;
+    filtered = false;
+    endResetModel();
+}
+
+void TaskTableModel::taskAdded(qint64 id)
+{
+    // a filter is refreshed by its owner, see MainWindow::searchTasks
+    if (filtered)
+        return;
+    auto position = std::upper_bound(
+        rows.constBegin(), rows.constEnd(), id,
+        [this](qint64 a, qint64 b) { return lessThan(a, b); });
+    int row = position - rows.constBegin();
+    beginInsertRows(QModelIndex(), row, row);
+    rows.insert(row, id);
+    rowIndexValid = false;
+    endInsertRows();
+}
+
+void TaskTableModel::tasksAdded(const QVector<qint64> &ids)
+{
+    // The tasks are sorted, appended as one block and then merged
+    // with the other rows, which keeps the persistent indexes. The
+    // merge costs one pass over the rows instead of sorting them all
+    // again for every page of a load. Pages come in deadline order
+    // and need no merge when the view is sorted by deadline.
+    if (filtered || ids.isEmpty())
+        return;
+    QVector<qint64> added = inSortOrder(ids);
+    int shown = rows.size();
+    bool inOrder = rows.isEmpty() || !lessThan(added.first(), rows.last());
+    beginInsertRows(QModelIndex(), shown, shown + added.size() - 1);
+    rows += added;
+    rowIndexValid = false;
+    endInsertRows();
+    if (inOrder)
+        return;
+    QVector<int> merged(rows.size());
+    std::iota(merged.begin(), merged.end(), 0);
+    std::inplace_merge(merged.begin(), merged.begin() + shown, merged.end(),
+                       [this](int a, int b) {
+                           return lessThan(rows.at(a), rows.at(b));
+                       });
+    reorder(merged);
+}
+
+QVector<int> TaskTableModel::sortPermutation(const QVector<qint64> &ids) const
+{
+    // The keys are read from the store once instead of on every
+    // comparison. Deadlines are compared as epoch seconds, not as the
+    // displayed text, and equal ones by id like the database's index.
+    // Without a sort column the tasks come in the store's order.
+    QVector<int> sorted(ids.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    if (sortColumn != NameColumn && sortColumn != DescColumn) {
+        QVector<QPair<qint64, qint64> > keys;
+        keys.reserve(ids.size());
+        for (qint64 id : ids)
+            keys.append(qMakePair(store->task(id).deadline, id));
+        sortRows(sorted, sortOrder, [&keys](int a, int b) {
+            return keys.at(a) < keys.at(b);
+        });
+    } else {
+        QVector<QString> keys;
+        keys.reserve(ids.size());
+        for (qint64 id : ids) {
+            const Task &task = store->task(id);
+            keys.append(sortColumn == NameColumn ? task.name : task.desc);
+        }
+        sortRows(sorted, sortOrder, [&keys](int a, int b) {
+            return keys.at(a).localeAwareCompare(keys.at(b)) < 0;
+        });
+    }
+    return sorted;
+}
+
+QVector<qint64> TaskTableModel::inSortOrder(const QVector<qint64> &ids) const
+{
+    QVector<qint64> sortedIds;
+    sortedIds.reserve(ids.size());
+    for (int i : sortPermutation(ids))
+        sortedIds.append(ids.at(i));
+    return sortedIds;
+}
+
+bool TaskTableModel::lessThan(qint64 first, qint64 second) const
+{
+    if (sortOrder == Qt::DescendingOrder)
+        std::swap(first, second);
+    const Task &a = store->task(first);
+    const Task &b = store->task(second);
+    if (sortColumn == NameColumn)
+        return a.name.localeAwareCompare(b.name) < 0;
+    if (sortColumn == DescColumn)
+        return a.desc.localeAwareCompare(b.desc) < 0;
+    return qMakePair(a.deadline, a.id) < qMakePair(b.deadline, b.id);
+}
+
+int TaskTableModel::rowOf(qint64 id) const
+{
+    // many tasks change at once when the overdue ones are dismissed,
+    // the index is built once for all of them
+    if (!rowIndexValid) {
+        rowIndex.clear();
+        rowIndex.reserve(rows.size());
+        for (int row = 0; row < rows.size(); row++)
+            rowIndex.insert(rows.at(row), row);
+        rowIndexValid = true;
+    }
+    return rowIndex.value(id, -1);
+}
+
+void TaskTableModel::taskChanged(qint64 id)
+{
+    int row = rowOf(id);
+    if (row >= 0)
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
+void TaskTableModel::taskRemoved(qint64 id)
+{
+    int row = rowOf(id);
+    if (row < 0)
+        return;
+    beginRemoveRows(QModelIndex(), row, row);
+    rows.remove(row);
+    rowIndexValid = false;
+    endRemoveRows();
+}
@@ -0,0 +1,79 @@
+/**
+  * This model shows the tasks of the current user in the
+  * main window's table. The tasks themselves live in
+  * TaskStore, the model only keeps the order of the rows
+  * as task ids and follows the store's signals. The texts
+  * are read from the stored task when the view asks for
+  * them, the styling is left to TaskItemDelegate.
+  *
+**/
+
+#ifndef TASKTABLEMODEL_H
+#define TASKTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QVector>
+#include "task.h"
+
+class TaskStore;
+
+class TaskTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+  public:
+    enum Columns { NameColumn, DescColumn, DeadlineColumn, ColumnCount };
+    enum Roles { IdRole = Qt::UserRole + 1, DeadlineRole };
+
+    explicit TaskTableModel(TaskStore *store, QObject *parent = 0);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const;
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+
+    const Task &task(int row) const;
+    // shows only the given tasks in the given order (e.g. search
+    // results ranked by relevance) until a column is sorted, and until
+    // clearFilter or the next reset of the store
+    void setFilter(const QVector<qint64> &);
+    void clearFilter();
+    bool isFiltered() const;
+
+  private slots:
+    void reset();
+    void taskAdded(qint64);
+    void tasksAdded(const QVector<qint64> &);
+    void taskChanged(qint64);
+    void taskRemoved(qint64);
+
+  private:
+    // the order in which the given tasks are shown
+    QVector<int> sortPermutation(const QVector<qint64> &) const;
+    // moves the rows into the given order (a permutation of the rows)
+    void reorder(const QVector<int> &);
+    QVector<qint64> inSortOrder(const QVector<qint64> &) const;
+    // whether the first task is shown above the second one
+    bool lessThan(qint64, qint64) const;
+    // the row of the task, -1 when it is not shown
+    int rowOf(qint64) const;
+
+    TaskStore *store;
+    // the id of the task shown on every row
+    QVector<qint64> rows;
+    // the row of every id in rows, rebuilt on the first lookup after
+    // the rows have changed
+    mutable QHash<qint64, int> rowIndex;
+    mutable bool rowIndexValid;
+    bool filtered;
+    // the last sort, kept for the rows which come later; -1 shows the
+    // rows of a filter in their given order and the others in the
+    // store's (deadline) order
+    int sortColumn;
+    Qt::SortOrder sortOrder;
+};
+
+#endif // TASKTABLEMODEL_H
@@ -9,6 +9,8 @@
 #include <QWidget>
 #include <QRegExpValidator>
 #include <QCloseEvent>
+#include <QCompleter>
+#include <QStringListModel>
 
 UserInputDialog::UserInputDialog(const QString &title, QWidget *parent)
     : QDialog(parent)
@@ -43,6 +45,23 @@ void UserInputDialog::createWidgets()
         new QRegExpValidator(QRegExp("[A-Za-z\\d_]+"), this));
     usernameLineEdit->setMaxLength(100);
     usernameLabel->setBuddy(usernameLineEdit);
+    usernames = new QStringListModel(this);
+    usernameCompleter = new QCompleter(usernames, this);
+    usernameLineEdit->setCompleter(usernameCompleter);
+}
+
+void UserInputDialog::setUsernameSuggestions(const QString &prefix,
+                                             const QStringList &suggestions)
+{
+    // the suggestions arrive after the key press they were asked for,
+    // so the popup is opened here rather than by the line edit
+    if (prefix != usernameLineEdit->text())
+        return;
+    usernames->setStringList(suggestions);
+    if (!suggestions.isEmpty() && usernameLineEdit->hasFocus()) {
+        usernameCompleter->setCompletionPrefix(prefix);
+        usernameCompleter->complete();
+    }
 }
 
 void UserInputDialog::createLayout()
@@ -64,6 +83,8 @@ void UserInputDialog::createConnections()
 {
     connect(buttonBox, SIGNAL(accepted()), this, SLOT(acceptInput()));
     connect(buttonBox, SIGNAL(rejected()), this, SLOT(close()));
+    connect(usernameLineEdit, SIGNAL(textEdited(const QString &)), this,
+            SIGNAL(usernameEdited(const QString &)));
 }
 
 void UserInputDialog::acceptInput()
@@ -9,6 +9,8 @@ class QDialogButtonBox;
 class QPushButton;
 class QWidget;
 class QCloseEvent;
+class QCompleter;
+class QStringListModel;
 
 class UserInputDialog : public QDialog
 {
@@ -16,11 +18,17 @@ class UserInputDialog : public QDialog
   public:
     explicit UserInputDialog(const QString &, QWidget *parent = 0);
 
+    // offers usernames starting with prefix for completion, ignored
+    // when the username has changed since
+    void setUsernameSuggestions(const QString &prefix, const QStringList &);
+
   protected:
     void closeEvent(QCloseEvent *event);
 
   signals:
     void accepted(const QString &, const QString &);
+    // the user has typed into the username field
+    void usernameEdited(const QString &);
 
   private slots:
     void acceptInput();
@@ -34,6 +42,8 @@ class UserInputDialog : public QDialog
     QLineEdit *nameLineEdit;
     QLabel *usernameLabel;
     QLineEdit *usernameLineEdit;
+    QCompleter *usernameCompleter;
+    QStringListModel *usernames;
     QDialogButtonBox *buttonBox;
     QPushButton *okButton;
     QPushButton *cancelButton;
@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Headless benchmarks for TasksDB. Run for example
+#   ./tasklist-bench --sizes 1000,100000
+#
+#-------------------------------------------------
+
+QT       = core sql
+
+CONFIG   += c++11 console
+CONFIG   -= app_bundle
+
+TARGET = tasklist-bench
+TEMPLATE = app
+
+include(../core/core.pri)
+
+SOURCES += main.cpp
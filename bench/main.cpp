@@ -0,0 +1,328 @@
+/**
+  *
+  * Benchmarks for the database layer. For every size a fresh
+  * database (a temporary file, or memory with --memory) gets a
+  * synthetic user whose tasks are imported from a generated
+  * file. Then the single-task and user operations, the task
+  * listing, the search, the reminder checks and the exports
+  * are timed. Each row of the report gives the number of
+  * runs, ops/sec and latency percentiles.
+  *
+**/
+
+#include "tasksdb.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+
+namespace
+{
+const QStringList Reminders = { "1 day",   "2 hrs",   "1 hr",
+                                "30 mins", "10 mins", "no reminder" };
+
+// single-task operations are repeated this many times
+const int TaskOperations = 1000;
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+int scanRepeats(int size)
+{
+    // operations which read every task of the user get fewer runs
+    // on the big accounts
+    return qBound(5, 1000000 / qMax(size, 1), 200);
+}
+
+QString importRate(const QString &name, const ImportReport &imported)
+{
+    // the time TasksDB spent storing the rows, without the setup
+    return QString("  %1: %2 rows in %3 ms, %4 rows/s\n")
+        .arg(name)
+        .arg(imported.imported)
+        .arg(imported.elapsed)
+        .arg(imported.rowsPerSecond());
+}
+
+void report(const QString &name, QVector<qint64> nsecs, int rows = 1)
+{
+    // nsecs holds the duration of every run, rows the number of
+    // rows one run handles (import and export run once over all)
+    if (nsecs.isEmpty())
+        return;
+    std::sort(nsecs.begin(), nsecs.end());
+    qint64 total = 0;
+    for (qint64 n : nsecs)
+        total += n;
+    auto percentile = [&nsecs](double p) {
+        int i = qMin(nsecs.size() - 1, int(p * nsecs.size()));
+        return nsecs.at(i) / 1000.0;
+    };
+    double opsPerSec = double(nsecs.size()) * rows * 1e9 / qMax(total, 1LL);
+    out() << QString("  %1 %2 %3 %4 %5 %6 %7\n")
+                 .arg(name, -22)
+                 .arg(nsecs.size(), 6)
+                 .arg(opsPerSec, 12, 'f', 0)
+                 .arg(percentile(0.50), 11, 'f', 1)
+                 .arg(percentile(0.90), 11, 'f', 1)
+                 .arg(percentile(0.99), 11, 'f', 1)
+                 .arg(nsecs.last() / 1000.0, 11, 'f', 1);
+    out().flush();
+}
+
+QVector<qint64> repeat(int times, const std::function<void(int)> &operation)
+{
+    QVector<qint64> nsecs;
+    nsecs.reserve(times);
+    QElapsedTimer timer;
+    for (int i = 0; i < times; i++) {
+        timer.start();
+        operation(i);
+        nsecs.append(timer.nsecsElapsed());
+    }
+    return nsecs;
+}
+
+bool writeTaskFile(const QString &fileName, int size, std::mt19937 &random)
+{
+    // deadlines are spread over 30 days before and after now so that
+    // all the reminder checks have something to find
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        return false;
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << MagicNumber() << "\n";
+    std::uniform_int_distribution<int> minutes(-30 * 24 * 60, 30 * 24 * 60);
+    std::uniform_int_distribution<int> reminder(0, Reminders.size() - 1);
+    QDateTime now = QDateTime::currentDateTime();
+    for (int i = 0; i < size; i++) {
+        stream << "Task " << i << "\n";
+        stream << "Synthetic benchmark task number " << i << "\n";
+        stream << now.addSecs(minutes(random) * 60LL)
+                      .toString("d.M.yyyy hh.mm") << "\n";
+        stream << Reminders.at(reminder(random)) << "\n";
+        stream << "\n";
+    }
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
+bool runSize(int size, bool memory, const ConnectionOptions &options,
+             const QTemporaryDir &dir)
+{
+    std::mt19937 random(size);
+    QString username = QString("bench%1").arg(size);
+    QString taskFile = dir.filePath(QString("tasks%1.txt").arg(size));
+    QString exportFile = dir.filePath(QString("export%1.txt").arg(size));
+    QString binaryFile = dir.filePath(QString("export%1.tasks").arg(size));
+    QString database =
+        memory ? QString(":memory:")
+               : dir.filePath(QString("tasklist%1.db").arg(size));
+
+    out() << QString("%1 tasks (%2, journal_mode %3, synchronous %4)\n")
+                 .arg(size)
+                 .arg(memory ? "in memory" : "temporary file")
+                 .arg(options.journalMode)
+                 .arg(options.synchronous);
+    out() << QString("  %1 %2 %3 %4 %5 %6 %7\n")
+                 .arg("operation", -22)
+                 .arg("runs", 6)
+                 .arg("ops/sec", 12)
+                 .arg("p50 us", 11)
+                 .arg("p90 us", 11)
+                 .arg("p99 us", 11)
+                 .arg("max us", 11);
+
+    if (!writeTaskFile(taskFile, size, random)) {
+        out() << "  cannot write " << taskFile << "\n";
+        return false;
+    }
+
+    TasksDB tasksDB(database, options);
+    Result result = tasksDB.status();
+    if (result)
+        result = tasksDB.addNewUser("Benchmark", username);
+    if (!result) {
+        out() << "  " << result.message << "\n";
+        return false;
+    }
+
+    ImportReport imported;
+    report("import", repeat(1, [&](int) {
+               imported = tasksDB.importFromFile(username, taskFile);
+           }),
+           size);
+    if (imported.imported != size) {
+        out() << "  import failed: " << imported.errors.join("; ") << "\n";
+        return false;
+    }
+    // the rates measured by TasksDB are printed below the table
+    QString importRates = importRate("import", imported);
+
+    // task ids run from 1 to size in a fresh database
+    std::uniform_int_distribution<qint64> anyTask(1, size);
+    QString deadline =
+        QDateTime::currentDateTime().addDays(1).toString("d.M.yyyy hh.mm");
+    QString created = QString::number(QDateTime::currentMSecsSinceEpoch());
+
+    QVector<qint64> added;
+    report("addNewTask", repeat(TaskOperations, [&](int i) {
+               added.append(tasksDB.addNewTask(
+                   username, QString("Added %1").arg(i), "Added by benchmark",
+                   deadline, TasksDB::DUE1HR, created));
+           }));
+    report("updateTask", repeat(TaskOperations, [&](int i) {
+               tasksDB.updateTask(username, anyTask(random),
+                                  QString("Updated %1").arg(i),
+                                  "Updated by benchmark", deadline,
+                                  TasksDB::DUE2HRS);
+           }));
+    report("setSnoozeForTask", repeat(TaskOperations, [&](int) {
+               tasksDB.setSnoozeForTask(username, anyTask(random),
+                                        TasksDB::S_5MINS,
+                                        QDateTime::currentDateTime().toString(
+                                            "d.M.yyyy hh.mm"));
+           }));
+    report("deleteTask", repeat(added.size(), [&](int i) {
+               tasksDB.deleteTask(username, added.at(i));
+           }));
+
+    report("addNewUser", repeat(TaskOperations, [&](int i) {
+               tasksDB.addNewUser("Benchmark",
+                                  QString("%1_user%2").arg(username).arg(i));
+           }));
+    report("findUsers (prefix)", repeat(TaskOperations, [&](int i) {
+               tasksDB.findUsers(QString("%1_user%2").arg(username).arg(i % 10),
+                                 20);
+           }));
+
+    int repeats = scanRepeats(size);
+    report("hasUser + first page", repeat(repeats, [&](int) {
+               tasksDB.hasUser("Benchmark", username);
+               tasksDB.getTasks(username, 0, 100);
+           }));
+    report("getTasks (all)", repeat(qMin(repeats, 20), [&](int) {
+               tasksDB.getTasks(username);
+           }));
+    // the pages TaskStore loads, in deadline order
+    report("getTasksByDeadline", repeat(qMin(repeats, 20), [&](int) {
+               Tasks page = tasksDB.getTasksByDeadline(
+                   username, std::numeric_limits<qint64>::min(), 0, 5000);
+               while (page.size() == 5000)
+                   page = tasksDB.getTasksByDeadline(
+                       username, page.last().deadline, page.last().id, 5000);
+           }));
+    report("searchTasks (prefix)", repeat(repeats, [&](int) {
+               tasksDB.searchTasks(username,
+                                   QString("number %1").arg(anyTask(random)),
+                                   100);
+           }));
+    // the first run dismisses the reminders of the overdue tasks, the
+    // following ones show the steady state
+    report("checkReminders", repeat(repeats, [&](int) {
+               tasksDB.checkReminders(username);
+           }));
+
+    int exported = 0;
+    QVector<qint64> exportTime = repeat(1, [&](int) {
+        result = tasksDB.exportToFile(username, exportFile, TasksDB::TextFile,
+                                      &exported);
+    });
+    report("exportToFile", exportTime, qMax(exported, 1));
+
+    // the binary file is read back into a second user
+    int binaryExported = 0;
+    if (result)
+        exportTime = repeat(1, [&](int) {
+            result = tasksDB.exportToFile(username, binaryFile,
+                                          TasksDB::BinaryFile,
+                                          &binaryExported);
+        });
+    if (result) {
+        report("exportToFile (binary)", exportTime, qMax(binaryExported, 1));
+        result = tasksDB.addNewUser("Benchmark", username + "b");
+    }
+    if (result) {
+        report("import (binary)", repeat(1, [&](int) {
+                   imported = tasksDB.importFromFile(username + "b",
+                                                     binaryFile);
+               }),
+               qMax(binaryExported, 1));
+        if (imported.imported != binaryExported)
+            result = Result(Result::FileError,
+                            "binary import failed: " +
+                                imported.errors.join("; "));
+        else
+            importRates += importRate("import (binary)", imported);
+    }
+
+    out() << importRates;
+    out() << QString("  statement cache: %1 hits, %2 misses\n\n")
+                 .arg(tasksDB.statementCacheHits())
+                 .arg(tasksDB.statementCacheMisses());
+    if (!result)
+        out() << "  " << result.message << "\n";
+    return bool(result);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("tasklist-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks for the Task List database.");
+    parser.addHelpOption();
+    QCommandLineOption sizesOption(
+        "sizes", "Comma separated task counts (default 1000,100000,1000000).",
+        "sizes", "1000,100000,1000000");
+    QCommandLineOption memoryOption(
+        "memory", "Use in-memory databases instead of temporary files.");
+    ConnectionOptions options;
+    QCommandLineOption journalOption(
+        "journal-mode",
+        QString("SQLite journal mode (default %1).").arg(options.journalMode),
+        "mode", options.journalMode);
+    QCommandLineOption synchronousOption(
+        "synchronous",
+        QString("SQLite synchronous level (default %1).")
+            .arg(options.synchronous),
+        "level", options.synchronous);
+    parser.addOption(sizesOption);
+    parser.addOption(memoryOption);
+    parser.addOption(journalOption);
+    parser.addOption(synchronousOption);
+    parser.process(app);
+    options.journalMode = parser.value(journalOption);
+    options.synchronous = parser.value(synchronousOption);
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        out() << "Cannot create a temporary directory\n";
+        return 1;
+    }
+    bool ok = true;
+    for (const auto &size : parser.value(sizesOption).split(',')) {
+        if (size.toInt() <= 0) {
+            out() << "Invalid size " << size << "\n";
+            return 1;
+        }
+        ok = runSize(size.toInt(), parser.isSet(memoryOption), options,
+                     dir) && ok;
+    }
+    return ok ? 0 : 1;
+}
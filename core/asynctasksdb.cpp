@@ -0,0 +1,338 @@
+/**
+  * The calls are posted as events to a worker object living
+  * in the database thread. Qt delivers the posted events of a
+  * receiver in order, which gives the calls their ordering.
+  * The worker creates TasksDB on the first call so that the
+  * connection belongs to the database thread.
+  *
+  * With write-behind the worker opens a transaction at the first
+  * single-task write and keeps adding writes to it until the
+  * latency has passed, the group is full or some other call
+  * arrives, so a group costs one commit instead of one per write.
+  *
+**/
+
+#include "asynctasksdb.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QFutureInterface>
+#include <QTimerEvent>
+
+namespace
+{
+// bounds the size of a transaction with write-behind
+const int MaxGroupedWrites = 1000;
+// marks the single-task writes, see DatabaseWorker
+const bool Grouped = true;
+
+class JobEvent : public QEvent
+{
+  public:
+    JobEvent(const std::function<void(TasksDB &)> &job, bool grouped)
+        : QEvent(jobType()), job(job), grouped(grouped)
+    {
+    }
+
+    static QEvent::Type jobType()
+    {
+        static const QEvent::Type type =
+            QEvent::Type(QEvent::registerEventType());
+        return type;
+    }
+
+    std::function<void(TasksDB &)> job;
+    // may be committed together with the writes around it
+    bool grouped;
+};
+}
+
+class DatabaseWorker : public QObject
+{
+  public:
+    DatabaseWorker(const QString &databaseName,
+                   const ConnectionOptions &options, AsyncTasksDB *owner)
+        : databaseName(databaseName), options(options), owner(owner),
+          tasksDB(0), grouped(0), flushTimer(0)
+    {
+    }
+
+    ~DatabaseWorker()
+    {
+        // deleted in the database thread, see ~AsyncTasksDB
+        flush();
+        delete tasksDB;
+    }
+
+    bool event(QEvent *event)
+    {
+        if (event->type() != JobEvent::jobType())
+            return QObject::event(event);
+        if (!tasksDB) {
+            tasksDB = new TasksDB(databaseName, options);
+            connect(tasksDB, SIGNAL(databaseError(const QString &)), owner,
+                    SIGNAL(databaseError(const QString &)));
+        }
+        JobEvent *job = static_cast<JobEvent *>(event);
+        if (!job->grouped || options.writeBehind <= 0) {
+            // the other calls may use transactions of their own
+            flush();
+            job->job(*tasksDB);
+            return true;
+        }
+        if (grouped == 0 && tasksDB->transaction())
+            flushTimer = startTimer(options.writeBehind);
+        job->job(*tasksDB);
+        if (flushTimer && ++grouped >= MaxGroupedWrites)
+            flush();
+        return true;
+    }
+
+  protected:
+    void timerEvent(QTimerEvent *event)
+    {
+        if (event->timerId() == flushTimer)
+            flush();
+    }
+
+  private:
+    void flush()
+    {
+        if (!flushTimer)
+            return;
+        killTimer(flushTimer);
+        flushTimer = 0;
+        grouped = 0;
+        // commit() has rolled back and reported the error
+        if (!tasksDB->commit())
+            emit owner->writesLost();
+    }
+
+    QString databaseName;
+    ConnectionOptions options;
+    AsyncTasksDB *owner;
+    TasksDB *tasksDB;
+    // the number of writes in the open transaction
+    int grouped;
+    // runs while a transaction is open
+    int flushTimer;
+};
+
+AsyncTasksDB::AsyncTasksDB(const QString &databaseName,
+                           const ConnectionOptions &options, QObject *parent)
+    : QObject(parent),
+      worker(new DatabaseWorker(databaseName, options, this))
+{
+    thread.setObjectName("TasksDB");
+    worker->moveToThread(&thread);
+    connect(worker, SIGNAL(destroyed()), &thread, SLOT(quit()),
+            Qt::DirectConnection);
+    thread.start();
+}
+
+AsyncTasksDB::~AsyncTasksDB()
+{
+    // The deletion is queued after the pending calls, it closes the
+    // connection in the database thread and then stops the thread.
+    worker->deleteLater();
+    thread.wait();
+}
+
+void AsyncTasksDB::post(const std::function<void(TasksDB &)> &job,
+                        bool grouped)
+{
+    QCoreApplication::postEvent(worker, new JobEvent(job, grouped));
+}
+
+template <typename T>
+QFuture<T> AsyncTasksDB::enqueue(const std::function<T(TasksDB &)> &job,
+                                 bool grouped)
+{
+    QFutureInterface<T> future;
+    future.reportStarted();
+    post([future, job](TasksDB &tasksDB) mutable {
+        T result = job(tasksDB);
+        future.reportResult(result);
+        future.reportFinished();
+    }, grouped);
+    return future.future();
+}
+
+template <>
+QFuture<void> AsyncTasksDB::enqueue(const std::function<void(TasksDB &)> &job,
+                                    bool grouped)
+{
+    QFutureInterface<void> future;
+    future.reportStarted();
+    post([future, job](TasksDB &tasksDB) mutable {
+        job(tasksDB);
+        future.reportFinished();
+    }, grouped);
+    return future.future();
+}
+
+QFuture<Result> AsyncTasksDB::status()
+{
+    return enqueue<Result>([](TasksDB &tasksDB) { return tasksDB.status(); });
+}
+
+QFuture<Result> AsyncTasksDB::addNewUser(const QString &name,
+                                         const QString &username)
+{
+    return enqueue<Result>([=](TasksDB &tasksDB) {
+        return tasksDB.addNewUser(name, username);
+    });
+}
+
+QFuture<Result> AsyncTasksDB::hasUser(const QString &name,
+                                      const QString &username)
+{
+    return enqueue<Result>([=](TasksDB &tasksDB) {
+        return tasksDB.hasUser(name, username);
+    });
+}
+
+QFuture<QStringList> AsyncTasksDB::findUsers(const QString &prefix,
+                                             int limit)
+{
+    return enqueue<QStringList>([=](TasksDB &tasksDB) {
+        return tasksDB.findUsers(prefix, limit);
+    });
+}
+
+QFuture<Tasks> AsyncTasksDB::getTasks(const QString &username,
+                                      qint64 afterId, int limit)
+{
+    return enqueue<Tasks>([=](TasksDB &tasksDB) {
+        return tasksDB.getTasks(username, afterId, limit);
+    });
+}
+
+QFuture<Tasks> AsyncTasksDB::getTasksByDeadline(const QString &username,
+                                                qint64 afterDeadline,
+                                                qint64 afterId, int limit)
+{
+    return enqueue<Tasks>([=](TasksDB &tasksDB) {
+        return tasksDB.getTasksByDeadline(username, afterDeadline, afterId,
+                                          limit);
+    });
+}
+
+QFuture<qint64> AsyncTasksDB::addNewTask(const QString &username,
+                                         const QString &taskName,
+                                         const QString &taskDesc,
+                                         const QString &taskDeadline,
+                                         int taskReminder,
+                                         const QString &taskCreated)
+{
+    return enqueue<qint64>([=](TasksDB &tasksDB) {
+        return tasksDB.addNewTask(username, taskName, taskDesc, taskDeadline,
+                                  taskReminder, taskCreated);
+    }, Grouped);
+}
+
+QFuture<void> AsyncTasksDB::updateTask(const QString &username, qint64 id,
+                                       const QString &taskName,
+                                       const QString &taskDesc,
+                                       const QString &taskDeadline,
+                                       int taskReminder)
+{
+    return enqueue<void>([=](TasksDB &tasksDB) {
+        tasksDB.updateTask(username, id, taskName, taskDesc, taskDeadline,
+                           taskReminder);
+    }, Grouped);
+}
+
+QFuture<void> AsyncTasksDB::deleteTask(const QString &username, qint64 id)
+{
+    return enqueue<void>(
+        [=](TasksDB &tasksDB) { tasksDB.deleteTask(username, id); }, Grouped);
+}
+
+QFuture<QVector<qint64> > AsyncTasksDB::searchTasks(const QString &username,
+                                                    const QString &text,
+                                                    int limit)
+{
+    return enqueue<QVector<qint64> >([=](TasksDB &tasksDB) {
+        return tasksDB.searchTasks(username, text, limit);
+    });
+}
+
+QFuture<ImportReport> AsyncTasksDB::importFromFile(const QString &username,
+                                                   const QString &fileName)
+{
+    return enqueue<ImportReport>([=](TasksDB &tasksDB) {
+        return tasksDB.importFromFile(username, fileName);
+    });
+}
+
+QFuture<ImportReport> AsyncTasksDB::importTasks(const QString &username,
+                                                const Tasks &tasks)
+{
+    return enqueue<ImportReport>([=](TasksDB &tasksDB) {
+        return tasksDB.importTasks(username, tasks);
+    });
+}
+
+QFuture<bool> AsyncTasksDB::stageTasks(int import, const Tasks &tasks)
+{
+    return enqueue<bool>([=](TasksDB &tasksDB) {
+        return tasksDB.stageTasks(import, tasks);
+    });
+}
+
+QFuture<ImportReport> AsyncTasksDB::importStaged(const QString &username,
+                                                 int import)
+{
+    return enqueue<ImportReport>([=](TasksDB &tasksDB) {
+        return tasksDB.importStaged(username, import);
+    });
+}
+
+QFuture<void> AsyncTasksDB::dropStaged(int import)
+{
+    return enqueue<void>([=](TasksDB &tasksDB) {
+        tasksDB.dropStaged(import);
+    });
+}
+
+QFuture<Result> AsyncTasksDB::exportToFile(const QString &username,
+                                           const QString &fileName,
+                                           TasksDB::FileFormat format)
+{
+    return enqueue<Result>([=](TasksDB &tasksDB) {
+        return tasksDB.exportToFile(username, fileName, format);
+    });
+}
+
+QFuture<Result> AsyncTasksDB::exportTask(const QString &username, qint64 id,
+                                         const QString &fileName)
+{
+    return enqueue<Result>([=](TasksDB &tasksDB) {
+        return tasksDB.exportTask(username, id, fileName);
+    });
+}
+
+QFuture<ReminderCheck> AsyncTasksDB::checkReminders(const QString &username)
+{
+    return enqueue<ReminderCheck>([=](TasksDB &tasksDB) {
+        return tasksDB.checkReminders(username);
+    });
+}
+
+QFuture<void> AsyncTasksDB::dismissReminder(const QString &username,
+                                            qint64 id)
+{
+    return enqueue<void>([=](TasksDB &tasksDB) {
+        tasksDB.dismissReminder(username, id);
+    }, Grouped);
+}
+
+QFuture<void> AsyncTasksDB::setSnoozeForTask(const QString &username,
+                                             qint64 id,
+                                             int snoozed,
+                                             const QString &snoozeCreated)
+{
+    return enqueue<void>([=](TasksDB &tasksDB) {
+        tasksDB.setSnoozeForTask(username, id, snoozed, snoozeCreated);
+    }, Grouped);
+}
@@ -0,0 +1,119 @@
+/**
+  * Runs TasksDB on a thread of its own. Every call is queued
+  * to the database thread and returns right away with a
+  * future for its result. The calls are executed one at a
+  * time in the order they were made, so for example a task
+  * is always stored before a later read of the same user's
+  * tasks. The database connection is created and used only
+  * in the database thread.
+  *
+  * With ConnectionOptions::writeBehind the single-task writes
+  * (adding, editing, deleting, dismissing and snoozing) are
+  * committed in groups. Their futures finish once the write
+  * has been executed, the commit follows within the given
+  * latency, and before any other call is executed. When the
+  * commit fails the group is rolled back and writesLost() is
+  * emitted, copies of the data have to be read again.
+  *
+**/
+
+#ifndef ASYNCTASKSDB_H
+#define ASYNCTASKSDB_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <functional>
+#include "tasksdb.h"
+
+class DatabaseWorker;
+
+class AsyncTasksDB : public QObject
+{
+    Q_OBJECT
+  public:
+    explicit AsyncTasksDB(const QString &databaseName = QString(),
+                          const ConnectionOptions &options =
+                              ConnectionOptions(),
+                          QObject *parent = 0);
+    // waits until the queued calls have been executed
+    ~AsyncTasksDB();
+
+    QFuture<Result> status();
+    QFuture<Result> addNewUser(const QString &, const QString &);
+    QFuture<Result> hasUser(const QString &, const QString &);
+    QFuture<QStringList> findUsers(const QString &, int limit = -1);
+    QFuture<Tasks> getTasks(const QString &, qint64 afterId = 0,
+                            int limit = -1);
+    QFuture<Tasks> getTasksByDeadline(const QString &, qint64, qint64,
+                                      int limit = -1);
+    QFuture<qint64> addNewTask(const QString &, const QString &,
+                               const QString &, const QString &, int,
+                               const QString &);
+    QFuture<void> updateTask(const QString &, qint64, const QString &,
+                             const QString &, const QString &, int);
+    QFuture<void> deleteTask(const QString &, qint64);
+    QFuture<QVector<qint64> > searchTasks(const QString &, const QString &,
+                                          int limit = -1);
+    QFuture<ImportReport> importFromFile(const QString &, const QString &);
+    QFuture<ImportReport> importTasks(const QString &, const Tasks &);
+    // may be called from any thread, see TaskImporter
+    QFuture<bool> stageTasks(int, const Tasks &);
+    QFuture<ImportReport> importStaged(const QString &, int);
+    QFuture<void> dropStaged(int);
+    QFuture<Result> exportToFile(
+        const QString &, const QString &,
+        TasksDB::FileFormat format = TasksDB::TextFile);
+    QFuture<Result> exportTask(const QString &, qint64, const QString &);
+    QFuture<ReminderCheck> checkReminders(const QString &);
+    QFuture<void> dismissReminder(const QString &, qint64);
+    QFuture<void> setSnoozeForTask(const QString &, qint64, int,
+                                   const QString &);
+
+signals:
+    // forwarded from TasksDB, delivered in the thread of this object
+    void databaseError(const QString &message);
+    // a group of writes whose futures have finished was rolled back
+    void writesLost();
+
+  private:
+    template <typename T>
+    QFuture<T> enqueue(const std::function<T(TasksDB &)> &job,
+                       bool grouped = false);
+    void post(const std::function<void(TasksDB &)> &job, bool grouped);
+
+    QThread thread;
+    DatabaseWorker *worker;
+};
+
+// Calls handler with the result of future once it has finished. The
+// handler runs in the thread of context and is dropped if context is
+// destroyed before that.
+template <typename T, typename Handler>
+void whenFinished(const QFuture<T> &future, QObject *context,
+                  Handler handler)
+{
+    auto watcher = new QFutureWatcher<T>(context);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, context,
+                     [watcher, handler]() {
+        watcher->deleteLater();
+        handler(watcher->result());
+    });
+    watcher->setFuture(future);
+}
+
+template <typename Handler>
+void whenFinished(const QFuture<void> &future, QObject *context,
+                  Handler handler)
+{
+    auto watcher = new QFutureWatcher<void>(context);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, context,
+                     [watcher, handler]() {
+        watcher->deleteLater();
+        handler();
+    });
+    watcher->setFuture(future);
+}
+
+#endif // ASYNCTASKSDB_H
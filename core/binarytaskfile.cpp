@@ -0,0 +1,143 @@
+#include "binarytaskfile.h"
+#include "tasksdb.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <QtEndian>
+
+namespace
+{
+const quint16 FormatVersion = 1;
+// magic, version, count and checksum
+const int HeaderSize = 4 + 2 + 4 + 2;
+const int MaxFieldLength = 100;
+
+void setFormat(QDataStream &stream)
+{
+    // the encoding must not change with the Qt version
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.setByteOrder(QDataStream::BigEndian);
+}
+}
+
+BinaryTaskWriter::BinaryTaskWriter(QIODevice *device)
+    : device(device), out(&records, QIODevice::WriteOnly), recordCount(0)
+{
+    setFormat(out);
+}
+
+void BinaryTaskWriter::append(const Task &task)
+{
+    QByteArray record;
+    QDataStream fields(&record, QIODevice::WriteOnly);
+    setFormat(fields);
+    fields << task.name << task.desc << task.deadline
+           << qint8(task.reminder);
+    out << record;
+    recordCount++;
+}
+
+bool BinaryTaskWriter::finish()
+{
+    QDataStream file(device);
+    setFormat(file);
+    file << MagicNumber() << FormatVersion << quint32(recordCount)
+         << qChecksum(records.constData(), records.size());
+    file.writeRawData(records.constData(), records.size());
+    return file.status() == QDataStream::Ok;
+}
+
+int BinaryTaskWriter::count() const
+{
+    return recordCount;
+}
+
+BinaryTaskReader::BinaryTaskReader(QIODevice *device) : device(device)
+{
+}
+
+bool BinaryTaskReader::isBinary(QIODevice *device)
+{
+    // a text file starts with the magic number in digits
+    QByteArray start = device->peek(4);
+    return start.size() == 4 &&
+           qFromBigEndian<quint32>(
+               reinterpret_cast<const uchar *>(start.constData())) ==
+               MagicNumber();
+}
+
+bool BinaryTaskReader::read()
+{
+    // The whole file is read at once and its checksum compared before
+    // any record is looked at. The count from the header sizes the
+    // task array up front.
+    QByteArray header = device->read(HeaderSize);
+    if (header.size() != HeaderSize)
+        return fail(tr("The file is too short."));
+    QDataStream in(header);
+    setFormat(in);
+    quint32 magic;
+    quint16 version;
+    quint32 count;
+    quint16 checksum;
+    in >> magic >> version >> count >> checksum;
+    if (magic != MagicNumber())
+        return fail(tr("The file is not recognized by this application."));
+    if (version > FormatVersion)
+        return fail(tr("The file was written in format version %1, this "
+                       "version of the program reads up to version %2.")
+                        .arg(version)
+                        .arg(FormatVersion));
+
+    QByteArray data = device->readAll();
+    if (qChecksum(data.constData(), data.size()) != checksum)
+        return fail(tr("The file is damaged, its checksum does not match."));
+
+    QDataStream recordStream(data);
+    setFormat(recordStream);
+    records.clear();
+    records.reserve(int(qMin(count, quint32(data.size()))));
+    for (quint32 i = 0; i < count; i++) {
+        QByteArray record;
+        recordStream >> record;
+        QDataStream fields(record);
+        setFormat(fields);
+        Task task;
+        qint8 reminder;
+        fields >> task.name >> task.desc >> task.deadline >> reminder;
+        if (recordStream.status() != QDataStream::Ok ||
+            fields.status() != QDataStream::Ok)
+            return fail(tr("Record %1 is incomplete.").arg(i + 1));
+        if (task.name.isEmpty() || task.name.length() > MaxFieldLength ||
+            task.desc.length() > MaxFieldLength)
+            return fail(tr("Record %1 has an invalid name or description.")
+                            .arg(i + 1));
+        if (reminder != TasksDB::NOREMINDER &&
+            TasksDB::reminderOffset(reminder) < 0)
+            return fail(tr("Record %1 has an unknown reminder.").arg(i + 1));
+        task.id = 0;
+        task.reminder = reminder;
+        task.snoozed = TasksDB::NOTSNOOZED;
+        task.snoozeTime = 0;
+        records.append(task);
+    }
+    if (!recordStream.atEnd())
+        return fail(tr("The file has more records than its header says."));
+    return true;
+}
+
+Tasks BinaryTaskReader::tasks() const
+{
+    return records;
+}
+
+QString BinaryTaskReader::errorString() const
+{
+    return error;
+}
+
+bool BinaryTaskReader::fail(const QString &message)
+{
+    error = message;
+    records.clear();
+    return false;
+}
@@ -0,0 +1,72 @@
+/**
+  * These classes write and read the binary task file format,
+  * a faster alternative to the text format for moving many
+  * tasks at once. Everything is written with QDataStream:
+  *
+  *   quint32 MagicNumber()
+  *   quint16 format version
+  *   quint32 number of records
+  *   quint16 CRC-16 (qChecksum) of the record bytes
+  *   the records, each a length-prefixed QByteArray holding
+  *   the name and the description (QString), the deadline
+  *   (qint64, UTC epoch seconds) and the reminder (qint8,
+  *   TasksDB::Reminders)
+  *
+  * The length prefix lets later versions append fields to a
+  * record. Times and reminders are stored as numbers, so no
+  * text has to be parsed when the file is read back.
+  *
+**/
+
+#ifndef BINARYTASKFILE_H
+#define BINARYTASKFILE_H
+
+#include <QCoreApplication>
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+#include "task.h"
+
+class QIODevice;
+
+class BinaryTaskWriter
+{
+  public:
+    explicit BinaryTaskWriter(QIODevice *device);
+
+    // the records are collected in memory, finish() writes the file
+    void append(const Task &);
+    bool finish();
+    int count() const;
+
+  private:
+    QIODevice *device;
+    QByteArray records;
+    QDataStream out;
+    int recordCount;
+};
+
+class BinaryTaskReader
+{
+    Q_DECLARE_TR_FUNCTIONS(BinaryTaskReader)
+  public:
+    explicit BinaryTaskReader(QIODevice *device);
+
+    // whether the device holds a binary task file, nothing is read
+    static bool isBinary(QIODevice *);
+
+    // reads and checks the whole file, returns false with an error
+    // message when it cannot be used
+    bool read();
+    Tasks tasks() const;
+    QString errorString() const;
+
+  private:
+    bool fail(const QString &);
+
+    QIODevice *device;
+    Tasks records;
+    QString error;
+};
+
+#endif // BINARYTASKFILE_H
@@ -0,0 +1,16 @@
+# Links a project against the core library, include this from the
+# projects which use it.
+
+QT += concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): CORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): CORE_DIR = $$OUT_PWD/../core/debug
+else: CORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$CORE_DIR -ltasklistcore
+
+win32-msvc*: PRE_TARGETDEPS += $$CORE_DIR/tasklistcore.lib
+else: PRE_TARGETDEPS += $$CORE_DIR/libtasklistcore.a
@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Storage and reminder logic of Task List. Depends only on
+# QtCore and QtSql so it can be used without a GUI.
+#
+#-------------------------------------------------
+
+QT       = core sql concurrent
+
+CONFIG   += c++11 staticlib
+
+TARGET = tasklistcore
+TEMPLATE = lib
+
+SOURCES += tasksdb.cpp \
+    taskfileparser.cpp \
+    reminderscheduler.cpp \
+    asynctasksdb.cpp \
+    taskstore.cpp \
+    binarytaskfile.cpp \
+    taskimporter.cpp
+
+HEADERS  += tasksdb.h \
+    taskfileparser.h \
+    reminderscheduler.h \
+    task.h \
+    result.h \
+    asynctasksdb.h \
+    taskstore.h \
+    binarytaskfile.h \
+    taskimporter.h
@@ -0,0 +1,75 @@
+/**
+  *
+  * The timer fires a little after the next fire time of the
+  * store, due() is emitted once for all the tasks whose time
+  * has come. The store is asked again from the last second
+  * handled, so an event in the current second is not lost
+  * when the timer is armed again before it fires.
+  *
+**/
+
+#include "reminderscheduler.h"
+#include "taskstore.h"
+#include <QTimer>
+#include <QDateTime>
+
+namespace
+{
+// Fire a little after the minute boundary since reminders are
+// matched with minute resolution.
+const qint64 FireMarginMSecs = 1000;
+// Long sleeps are split so that the timer interval fits into an int.
+const qint64 MaxSleepMSecs = 1000 * 60 * 60 * 24;
+}
+
+ReminderScheduler::ReminderScheduler(TaskStore *store, QObject *parent)
+    : QObject(parent), store(store), handled(currentSecs())
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, SIGNAL(timeout()), this, SLOT(fire()));
+    rearm = new QTimer(this);
+    rearm->setSingleShot(true);
+    rearm->setInterval(0);
+    connect(rearm, SIGNAL(timeout()), this, SLOT(arm()));
+    connect(store, SIGNAL(reset()), this, SLOT(reset()));
+    connect(store, SIGNAL(taskAdded(qint64)), rearm, SLOT(start()));
+    connect(store, SIGNAL(tasksAdded(const QVector<qint64> &)), rearm,
+            SLOT(start()));
+    connect(store, SIGNAL(taskChanged(qint64)), rearm, SLOT(start()));
+    connect(store, SIGNAL(taskRemoved(qint64)), rearm, SLOT(start()));
+}
+
+void ReminderScheduler::reset()
+{
+    // the reminders of a loaded user are checked once the load has
+    // finished, see MainWindow
+    handled = currentSecs();
+    arm();
+}
+
+void ReminderScheduler::fire()
+{
+    handled = currentSecs();
+    arm();
+    emit due();
+}
+
+qint64 ReminderScheduler::currentSecs()
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000;
+}
+
+void ReminderScheduler::arm()
+{
+    rearm->stop();
+    qint64 next = store->nextFireTime(handled);
+    if (next == 0) {
+        timer->stop();
+        return;
+    }
+    qint64 wait = next * 1000 + FireMarginMSecs -
+                  QDateTime::currentMSecsSinceEpoch();
+    timer->start(static_cast<int>(qBound(qint64(0), wait, MaxSleepMSecs)));
+}
@@ -0,0 +1,45 @@
+/**
+  * This class arms a single-shot timer for the next moment
+  * at which a reminder check has something to report, so
+  * reminders are only checked when something is actually
+  * due. The moments come from the fire times TaskStore keeps
+  * for its tasks (see TaskStore::nextFireTime), the timer is
+  * armed again once the store has changed.
+  *
+**/
+
+#ifndef REMINDERSCHEDULER_H
+#define REMINDERSCHEDULER_H
+
+#include <QObject>
+
+class QTimer;
+class TaskStore;
+
+class ReminderScheduler : public QObject
+{
+    Q_OBJECT
+  public:
+    explicit ReminderScheduler(TaskStore *store, QObject *parent = 0);
+
+  signals:
+    void due();
+
+  private slots:
+    void fire();
+    void reset();
+    void arm();
+
+  private:
+    static qint64 currentSecs();
+
+    TaskStore *store;
+    // the events up to this epoch second have been reported
+    qint64 handled;
+    QTimer *timer;
+    // arms the timer once after a burst of changes in the store, e.g.
+    // when the overdue tasks are dismissed
+    QTimer *rearm;
+};
+
+#endif // REMINDERSCHEDULER_H
@@ -0,0 +1,41 @@
+/**
+  * Outcome of a TasksDB operation. The core library never shows
+  * dialogs itself, the caller decides how to present an error. The
+  * message is a translated sentence which can be shown to the user
+  * as is.
+  *
+**/
+
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <QString>
+
+struct Result
+{
+    enum Code {
+        Ok,
+        InvalidArgument,
+        AlreadyExists,
+        NotFound,
+        FileError,
+        DatabaseError
+    };
+
+    Result() : code(Ok)
+    {
+    }
+    Result(Code code, const QString &message) : code(code), message(message)
+    {
+    }
+
+    explicit operator bool() const
+    {
+        return code == Ok;
+    }
+
+    Code code;
+    QString message;
+};
+
+#endif // RESULT_H
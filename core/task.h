@@ -0,0 +1,54 @@
+/**
+  * A task as it is kept in memory. Times are stored the same
+  * way as in the database (UTC epoch seconds) and only turned
+  * into text when they are shown.
+  *
+**/
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <QString>
+#include <QVector>
+
+struct Task
+{
+    qint64 id;
+    QString name;
+    QString desc;
+    qint64 deadline;
+    // TasksDB::Reminders
+    int reminder;
+    // TasksDB::Snoozed and when the snooze was set
+    int snoozed;
+    qint64 snoozeTime;
+};
+
+Q_DECLARE_TYPEINFO(Task, Q_MOVABLE_TYPE);
+
+using Tasks = QVector<Task>;
+
+// A task which needs the user's attention, see TasksDB::checkReminders.
+struct Reminder
+{
+    qint64 id;
+    QString name;
+    qint64 deadline;
+    // the time left until (or past) the deadline as shown to the user
+    QString dueIn;
+    // TasksDB::Snoozed
+    int snoozed;
+};
+
+Q_DECLARE_TYPEINFO(Reminder, Q_MOVABLE_TYPE);
+
+// Everything one reminder check found, grouped by the reason.
+struct ReminderCheck
+{
+    QVector<Reminder> due;
+    QVector<Reminder> snoozed;
+    QVector<Reminder> overdue;
+    QVector<Reminder> pending;
+};
+
+#endif // TASK_H
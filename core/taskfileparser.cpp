@@ -0,0 +1,111 @@
+#include "taskfileparser.h"
+#include "tasksdb.h"
+#include <QDateTime>
+#include <QIODevice>
+
+namespace
+{
+// Only the first problems are kept as messages, the rest are counted.
+const int MaxErrorMessages = 100;
+const int MaxFieldLength = 100;
+}
+
+TaskFileParser::TaskFileParser(QIODevice *device)
+    : in(device), lineno(0), recordCount(0), errorTotal(0)
+{
+    in.setCodec("UTF-8");
+}
+
+bool TaskFileParser::readHeader()
+{
+    quint32 magic = readLine().toUInt();
+    if (magic != MagicNumber()) {
+        addError(lineno, tr("The file is not recognized by this application."));
+        return false;
+    }
+    return true;
+}
+
+bool TaskFileParser::next(TaskRecord &record)
+{
+    // Reads the next record and checks all of its fields. Returns false
+    // at the end of the file. A record with problems is still returned
+    // so that the caller can keep going; errorCount() tells whether
+    // anything was wrong so far.
+
+    if (in.atEnd())
+        return false;
+
+    int errorsBefore = errorTotal;
+    record.name = readLine();
+    record.line = lineno;
+    if (record.name.isEmpty()) {
+        addError(lineno, tr("The task has no name. Notice that tasks are "
+                            "separated from each other with an empty line."));
+    } else if (record.name.length() > MaxFieldLength) {
+        addError(lineno, tr("Task's name cannot be longer than %1 characters.")
+                             .arg(MaxFieldLength));
+    }
+
+    record.desc = readLine();
+    if (record.desc.length() > MaxFieldLength) {
+        addError(lineno,
+                 tr("Task's description cannot be longer than %1 characters.")
+                     .arg(MaxFieldLength));
+    }
+
+    record.deadline = readLine();
+    if (record.deadline.isEmpty()) {
+        addError(lineno, tr("No deadline given. Use the datetime format "
+                            "d.M.yyyy hh.mm."));
+    } else if (!QDateTime::fromString(record.deadline, "d.M.yyyy hh.mm")
+                    .isValid()) {
+        addError(lineno, tr("Deadline \"%1\" is not in the datetime format "
+                            "d.M.yyyy hh.mm.")
+                             .arg(record.deadline));
+    }
+
+    static const QStringList reminders = TasksDB::reminderLabels();
+    record.reminder = readLine();
+    if (!reminders.contains(record.reminder)) {
+        addError(lineno, tr("Reminder \"%1\" is not valid. Correct reminders "
+                            "are %2.")
+                             .arg(record.reminder)
+                             .arg(reminders.join(", ")));
+    }
+
+    // the empty line separating the records
+    readLine();
+
+    if (errorTotal == errorsBefore)
+        recordCount++;
+    return true;
+}
+
+int TaskFileParser::validRecords() const
+{
+    return recordCount;
+}
+
+int TaskFileParser::errorCount() const
+{
+    return errorTotal;
+}
+
+QStringList TaskFileParser::errors() const
+{
+    return messages;
+}
+
+QString TaskFileParser::readLine()
+{
+    lineno++;
+    return in.readLine();
+}
+
+void TaskFileParser::addError(int line, const QString &message)
+{
+    errorTotal++;
+    if (messages.size() < MaxErrorMessages)
+        messages.append(tr("Line %1: %2").arg(line).arg(message));
+}
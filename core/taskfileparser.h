@@ -0,0 +1,53 @@
+/**
+  * This class reads the task file format written by
+  * TasksDB (magic number line followed by name, description,
+  * deadline and reminder lines separated by an empty line)
+  * one record at a time. Problems are collected together with
+  * their line numbers instead of being shown to the user.
+  *
+**/
+
+#ifndef TASKFILEPARSER_H
+#define TASKFILEPARSER_H
+
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+class QIODevice;
+
+struct TaskRecord
+{
+    QString name;
+    QString desc;
+    QString deadline;
+    QString reminder;
+    int line;
+};
+
+class TaskFileParser
+{
+    Q_DECLARE_TR_FUNCTIONS(TaskFileParser)
+  public:
+    explicit TaskFileParser(QIODevice *device);
+
+    bool readHeader();
+    bool next(TaskRecord &record);
+
+    int validRecords() const;
+    int errorCount() const;
+    QStringList errors() const;
+
+  private:
+    QString readLine();
+    void addError(int line, const QString &message);
+
+    QTextStream in;
+    int lineno;
+    int recordCount;
+    int errorTotal;
+    QStringList messages;
+};
+
+#endif // TASKFILEPARSER_H
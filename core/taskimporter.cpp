@@ -0,0 +1,253 @@
+#include "taskimporter.h"
+#include "asynctasksdb.h"
+#include "taskfileparser.h"
+#include "binarytaskfile.h"
+#include <QFile>
+#include <QtConcurrent/QtConcurrentMap>
+#include <numeric>
+
+namespace
+{
+// the number of tasks staged by one call
+const int ImportChunkSize = 5000;
+
+// Collects the tasks of one file into chunks and stages them. Before
+// a chunk is sent the one before has to be staged, so the file is at
+// most two chunks ahead of the database.
+class ChunkStager
+{
+  public:
+    ChunkStager(AsyncTasksDB *tasksDB, int import)
+        : tasksDB(tasksDB), import(import), pending(false), staged(true)
+    {
+        chunk.reserve(ImportChunkSize);
+    }
+
+    // false once a chunk could not be staged
+    bool add(const Task &task)
+    {
+        chunk.append(task);
+        return chunk.size() < ImportChunkSize || flush();
+    }
+
+    bool flush()
+    {
+        if (!wait() || chunk.isEmpty())
+            return staged;
+        future = tasksDB->stageTasks(import, chunk);
+        pending = true;
+        chunk.clear();
+        return true;
+    }
+
+    bool wait()
+    {
+        if (pending) {
+            pending = false;
+            staged = future.result();
+        }
+        return staged;
+    }
+
+  private:
+    AsyncTasksDB *tasksDB;
+    int import;
+    Tasks chunk;
+    QFuture<bool> future;
+    bool pending;
+    bool staged;
+};
+
+// Parses the file with the given number in a thread of the pool and
+// stages its tasks under that number. The report holds the problems
+// of the file; a file with problems is dropped from the stage.
+struct StageFile
+{
+    typedef ImportReport result_type;
+
+    ImportReport operator()(int import) const
+    {
+        ImportReport report;
+        QFile file(fileNames.at(import));
+        if (!file.open(QFile::ReadOnly)) {
+            report.errorCount = 1;
+            report.errors << TaskImporter::tr("Cannot open file %1 for "
+                                              "reading: %2")
+                                 .arg(file.fileName())
+                                 .arg(file.errorString());
+            return report;
+        }
+        ChunkStager stager(tasksDB, import);
+        bool staged = true;
+        if (BinaryTaskReader::isBinary(&file)) {
+            // the checksum covers all records, the file is read at once
+            BinaryTaskReader reader(&file);
+            if (!reader.read()) {
+                report.errorCount = 1;
+                report.errors << reader.errorString();
+                return report;
+            }
+            for (const Task &task : reader.tasks()) {
+                if (!(staged = stager.add(task)))
+                    break;
+            }
+        } else {
+            // parsing goes on after a bad record to collect every
+            // problem, but nothing more is staged
+            TaskFileParser parser(&file);
+            if (parser.readHeader()) {
+                TaskRecord record;
+                Task task;
+                task.id = 0;
+                task.snoozed = TasksDB::NOTSNOOZED;
+                task.snoozeTime = 0;
+                while (parser.next(record)) {
+                    if (!staged || parser.errorCount() > 0)
+                        continue;
+                    task.name = record.name;
+                    task.desc = record.desc;
+                    task.deadline = TasksDB::toEpoch(record.deadline);
+                    task.reminder = TasksDB::reminderCode(record.reminder);
+                    staged = stager.add(task);
+                }
+            }
+            report.errorCount = parser.errorCount();
+            report.errors = parser.errors();
+        }
+        staged = staged && stager.flush() && stager.wait();
+        if (!staged) {
+            report.errorCount++;
+            report.errors << TaskImporter::tr("The tasks could not be "
+                                              "stored.");
+        }
+        if (report.errorCount > 0)
+            tasksDB->dropStaged(import);
+        return report;
+    }
+
+    AsyncTasksDB *tasksDB;
+    QStringList fileNames;
+};
+}
+
+TaskImporter::TaskImporter(AsyncTasksDB *tasksDB, QObject *parent)
+    : QObject(parent), tasksDB(tasksDB), running(false), staging(false),
+      cancelled(false), done(0), pending(0)
+{
+    connect(&watcher, SIGNAL(resultReadyAt(int)), this,
+            SLOT(fileStaged(int)));
+    connect(&watcher, SIGNAL(finished()), this, SLOT(stagingFinished()));
+}
+
+TaskImporter::~TaskImporter()
+{
+    watcher.cancel();
+    watcher.waitForFinished();
+}
+
+void TaskImporter::start(const QString &user, const QStringList &fileNames)
+{
+    if (running)
+        return;
+    username = user;
+    files.clear();
+    files.resize(fileNames.size());
+    for (int i = 0; i < fileNames.size(); i++) {
+        files[i].fileName = fileNames.at(i);
+        // until the file has been parsed
+        files[i].cancelled = true;
+    }
+    running = true;
+    staging = true;
+    cancelled = false;
+    done = 0;
+    pending = 0;
+    emit progress(0, files.size());
+    // each file arrives in fileStaged as soon as it has been parsed,
+    // the files are staged under their index
+    QVector<int> imports(files.size());
+    std::iota(imports.begin(), imports.end(), 0);
+    watcher.setFuture(
+        QtConcurrent::mapped(imports, StageFile{ tasksDB, fileNames }));
+}
+
+bool TaskImporter::isRunning() const
+{
+    return running;
+}
+
+QString TaskImporter::user() const
+{
+    return username;
+}
+
+QVector<FileImport> TaskImporter::results() const
+{
+    return files;
+}
+
+int TaskImporter::imported() const
+{
+    int total = 0;
+    for (const FileImport &file : files)
+        total += file.report.imported;
+    return total;
+}
+
+void TaskImporter::cancel()
+{
+    if (!running || cancelled)
+        return;
+    cancelled = true;
+    watcher.cancel();
+}
+
+void TaskImporter::fileStaged(int index)
+{
+    // a file parsed while the import was being cancelled is skipped
+    // too, see finishIfDone
+    if (cancelled)
+        return;
+    ImportReport parsed = watcher.resultAt(index);
+    files[index].cancelled = false;
+    if (parsed.errorCount > 0) {
+        files[index].report = parsed;
+        fileDone();
+        return;
+    }
+    pending++;
+    whenFinished(tasksDB->importStaged(username, index), this,
+                 [this, index](const ImportReport &report) {
+        files[index].report = report;
+        pending--;
+        fileDone();
+    });
+}
+
+void TaskImporter::stagingFinished()
+{
+    staging = false;
+    finishIfDone();
+}
+
+void TaskImporter::fileDone()
+{
+    done++;
+    emit progress(done, files.size());
+    finishIfDone();
+}
+
+void TaskImporter::finishIfDone()
+{
+    if (!running || staging || pending > 0)
+        return;
+    running = false;
+    // the chunks of files skipped after they were (partly) staged are
+    // dropped, the next import stages under the same numbers
+    for (int i = 0; i < files.size(); i++) {
+        if (files.at(i).cancelled)
+            tasksDB->dropStaged(i);
+    }
+    watcher.setFuture(QFuture<ImportReport>());
+    emit finished();
+}
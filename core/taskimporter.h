@@ -0,0 +1,81 @@
+/**
+  * This class imports many task files at once. The files
+  * are parsed in parallel on the global thread pool, each
+  * one into chunks of tasks which are staged in the
+  * database thread as they come (see TasksDB::stageTasks).
+  * A pool thread holds at most two chunks, so memory use
+  * does not grow with the files. Each file without problems
+  * is then stored in one transaction by importStaged, so a
+  * file is imported completely or not at all. The outcome
+  * of every file is kept for a summary.
+  *
+**/
+
+#ifndef TASKIMPORTER_H
+#define TASKIMPORTER_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QVector>
+#include "tasksdb.h"
+
+class AsyncTasksDB;
+
+struct FileImport
+{
+    QString fileName;
+    ImportReport report;
+    // the file was not read because the import was cancelled
+    bool cancelled = false;
+};
+
+class TaskImporter : public QObject
+{
+    Q_OBJECT
+  public:
+    explicit TaskImporter(AsyncTasksDB *tasksDB, QObject *parent = 0);
+    // waits for the files being parsed, they use tasksDB
+    ~TaskImporter();
+
+    // does nothing while an import is running
+    void start(const QString &, const QStringList &);
+    bool isRunning() const;
+    QString user() const;
+    // one entry per file in the order they were given
+    QVector<FileImport> results() const;
+    int imported() const;
+
+  public slots:
+    // the files which have not been parsed yet are skipped, the ones
+    // already passed to the database are still imported
+    void cancel();
+
+  signals:
+    // done files of total, a file is done once it has been stored or
+    // rejected
+    void progress(int done, int total);
+    void finished();
+
+  private slots:
+    void fileStaged(int);
+    void stagingFinished();
+
+  private:
+    void fileDone();
+    void finishIfDone();
+
+    AsyncTasksDB *tasksDB;
+    QFutureWatcher<ImportReport> watcher;
+    QString username;
+    QVector<FileImport> files;
+    bool running;
+    // files are still being parsed
+    bool staging;
+    bool cancelled;
+    int done;
+    // files passed to the database whose import has not finished
+    int pending;
+};
+
+#endif // TASKIMPORTER_H
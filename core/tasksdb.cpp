@@ -0,0 +1,1512 @@
+/**
+  *
+  * This class provides an interface for storing and
+  * handling user tasks. The program stores different
+  * users to a database based on usernames which means
+  * that usernames must be unique.
+  *
+**/
+
+#include "tasksdb.h"
+#include "taskfileparser.h"
+#include "binarytaskfile.h"
+#include <QDebug>
+#include <QStandardPaths>
+#include <QtSql/QSqlError>
+#include <QDir>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+namespace
+{
+const int SchemaVersion = 5;
+// Number of prepared statements kept around by TasksDB::prepare.
+const int StatementCacheSize = 32;
+// The migrations build the new Tasks table under this name. Older
+// versions named a table after every user, unquoted, so a name with a
+// space cannot be taken (table names ignore case, a user "tasks" had
+// a table called Tasks).
+const char *const UpgradeTable = "\"Tasks upgrade\"";
+
+QString durationText(qint64 secs)
+{
+    return QString("%1 hours %2 mins").arg(secs / 3600).arg(secs / 60 % 60);
+}
+
+// the "due in" text of a reminder which fires secs before the deadline
+QString dueText(qint64 secs)
+{
+    switch (secs) {
+    case 60 * 60 * 24:
+        return "1 day";
+    case 60 * 60 * 2:
+        return "2 hours";
+    case 60 * 60:
+        return "1 hour";
+    default:
+        return QString("%1 mins").arg(secs / 60);
+    }
+}
+
+// the labels in the order of TasksDB::Reminders and TasksDB::Snoozed
+const char *const ReminderLabels[] = { "1 day", "2 hrs", "1 hr", "30 mins",
+                                       "10 mins" };
+const int ReminderCount = sizeof(ReminderLabels) / sizeof(*ReminderLabels);
+const char *const NoReminderLabel = "no reminder";
+const char *const SnoozeLabels[] = { "5 mins before start",
+                                     "10 mins before start",
+                                     "5 mins",
+                                     "10 mins",
+                                     "15 mins",
+                                     "30 mins",
+                                     "1 hour",
+                                     "2 hours",
+                                     "4 hours" };
+const int SnoozeCount = sizeof(SnoozeLabels) / sizeof(*SnoozeLabels);
+
+QString labelsToCodes(const QString &column, const char *const labels[],
+                      int count, int unknown)
+{
+    // an SQL expression turning the labels stored by version 3 and
+    // older into codes
+    QString expression = QString("CASE %1").arg(column);
+    for (int code = 0; code < count; code++)
+        expression += QString(" WHEN '%1' THEN %2").arg(labels[code]).arg(code);
+    return expression + QString(" ELSE %1 END").arg(unknown);
+}
+
+QString createTasksTable(const QString &name)
+{
+    // All tasks live in one table keyed by the owner's user id.
+    // deadline and snoozetime are stored as UTC epoch seconds and
+    // created as UTC epoch milliseconds. reminder and snoozed hold
+    // TasksDB::Reminders and TasksDB::Snoozed codes. next_fire_at is
+    // the epoch second at which checkReminders has to look at the task
+    // next (0 for never), see nextFireAt.
+    return QString(
+        "CREATE TABLE IF NOT EXISTS "
+        "%1 (id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "user_id INTEGER NOT NULL REFERENCES Users(id) ON DELETE CASCADE, "
+        "name TEXT NOT NULL, "
+        "desc TEXT NOT NULL, "
+        "deadline INTEGER NOT NULL, "
+        "reminder INTEGER NOT NULL, "
+        "created INTEGER NOT NULL, "
+        "snoozed INTEGER NOT NULL, "
+        "snoozetime INTEGER NOT NULL, "
+        "next_fire_at INTEGER NOT NULL DEFAULT 0);").arg(name);
+}
+}
+
+TasksDB::TasksDB(const QString &databaseName,
+                 const ConnectionOptions &options, QObject *parent)
+    : QObject(parent), searchIndex(false), statements(StatementCacheSize),
+      cacheHits(0), cacheMisses(0)
+{
+    createConnection(databaseName, options);
+}
+
+TasksDB::~TasksDB()
+{
+    // the cached statements have to go before the connection is closed
+    statements.clear();
+    QString connectionName = db.connectionName();
+    db.close();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+Result TasksDB::status() const
+{
+    return openStatus;
+}
+
+bool TasksDB::transaction() const
+{
+    QSqlDatabase connection = db;
+    if (connection.transaction())
+        return true;
+    emit databaseError(connection.lastError().text());
+    return false;
+}
+
+bool TasksDB::commit() const
+{
+    QSqlDatabase connection = db;
+    if (connection.commit())
+        return true;
+    emit databaseError(connection.lastError().text());
+    connection.rollback();
+    return false;
+}
+
+QSqlQuery TasksDB::prepare(const QString &statement) const
+{
+    // Prepared statements are kept in an LRU cache keyed by their SQL
+    // text. A cached statement is only reset here; the caller binds new
+    // values to it, so SQLite does not parse and plan it again. The
+    // returned query shares its statement with the cached copy.
+    // Callers which do not read a query to its end finish() it, an
+    // active statement would keep a read transaction open.
+    if (QSqlQuery *cached = statements.object(statement)) {
+        ++cacheHits;
+        cached->finish();
+        return *cached;
+    }
+    ++cacheMisses;
+    QSqlQuery query = prepareOnce(statement);
+    // a statement which failed to prepare is reported again next time
+    if (!query.lastQuery().isEmpty())
+        statements.insert(statement, new QSqlQuery(query));
+    return query;
+}
+
+QSqlQuery TasksDB::prepareOnce(const QString &statement) const
+{
+    // schema changes and other one-off statements bypass the cache
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.prepare(statement)) {
+        qWarning() << Q_FUNC_INFO << "failed to prepare query";
+        qWarning() << query.lastQuery();
+        qWarning() << query.lastError().text();
+        emit databaseError(query.lastError().text());
+        return QSqlQuery();
+    }
+    return query;
+}
+
+bool TasksDB::execute(QSqlQuery &query) const
+{
+    if (!query.exec()) {
+        qWarning() << Q_FUNC_INFO << "failed execute query";
+        qWarning() << query.lastQuery();
+        qWarning() << query.lastError().text();
+        emit databaseError(query.lastError().text());
+        return false;
+    }
+    return true;
+}
+
+void TasksDB::createConnection(const QString &databaseName,
+                               const ConnectionOptions &options)
+{
+    // An empty name means the user's database in the application data
+    // directory. Anything else is handed to SQLite as is, so the
+    // benchmarks can use a temporary file or ":memory:".
+    // Each instance has a connection of its own, named after it, as a
+    // connection may only be used in the thread which created it.
+    db = QSqlDatabase::addDatabase(
+        "QSQLITE", QString("tasklist-%1").arg(quintptr(this), 0, 16));
+    if (databaseName.isEmpty()) {
+        QString databaseDir =
+            QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+        const QString dbFileName = QString("_tasklist.db");
+        QDir dir(databaseDir);
+        if (!QDir().mkpath(databaseDir)) {
+            openStatus = Result(Result::FileError,
+                                tr("Cannot create directory %1.")
+                                    .arg(databaseDir));
+            return;
+        }
+        db.setDatabaseName(dir.absoluteFilePath(dbFileName));
+    } else {
+        db.setDatabaseName(databaseName);
+    }
+    if (!db.open()) {
+        openStatus = Result(Result::DatabaseError,
+                            tr("Error while opening the database: %1")
+                                .arg(db.lastError().text()));
+        return;
+    }
+
+    // the busy timeout comes first, changing the journal mode needs a
+    // lock on the database
+    QStringList pragmas;
+    pragmas << QString("PRAGMA busy_timeout = %1;").arg(options.busyTimeout);
+    if (!options.journalMode.isEmpty())
+        pragmas << QString("PRAGMA journal_mode = %1;")
+                       .arg(options.journalMode);
+    if (!options.synchronous.isEmpty())
+        pragmas << QString("PRAGMA synchronous = %1;")
+                       .arg(options.synchronous);
+    pragmas << QString("PRAGMA cache_size = %1;").arg(options.cacheSize)
+            << QString("PRAGMA mmap_size = %1;").arg(options.mmapSize)
+            << QString("PRAGMA foreign_keys = ON;");
+    for (const QString &pragma : pragmas) {
+        QSqlQuery query = prepareOnce(pragma);
+        execute(query);
+    }
+
+    createInitialData();
+}
+
+void TasksDB::createInitialData()
+{
+    QSqlQuery query = prepareOnce(QString(
+        "SELECT name FROM sqlite_master WHERE type = 'table' "
+        "AND name = 'Users';"));
+    bool freshDatabase = execute(query) && !query.next();
+    query.finish();
+
+    query = prepareOnce(QString("CREATE TABLE IF NOT EXISTS "
+                                "Users (id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                                "name TEXT NOT NULL, "
+                                "username TEXT NOT NULL);"));
+    execute(query);
+
+    // the Tasks table of an old database is built by migrate(), a
+    // table of that name may still belong to a user
+    if (freshDatabase)
+        setSchemaVersion(SchemaVersion);
+    else
+        migrate();
+    if (!openStatus)
+        return;
+    query = prepareOnce(createTasksTable("Tasks"));
+    execute(query);
+
+    // the indexes come last as migrate() may rebuild the Tasks table;
+    // the unique index on username makes the duplicate check of
+    // addNewUser and the lookups by username O(log n)
+    query = prepareOnce(QString("CREATE UNIQUE INDEX IF NOT EXISTS "
+                                "Users_username ON Users (username);"));
+    execute(query);
+    query = prepareOnce(QString("CREATE INDEX IF NOT EXISTS "
+                                "Tasks_user_deadline "
+                                "ON Tasks (user_id, deadline);"));
+    execute(query);
+    query = prepareOnce(QString("CREATE INDEX IF NOT EXISTS Tasks_user_id "
+                                "ON Tasks (user_id, id);"));
+    execute(query);
+    query = prepareOnce(QString("CREATE INDEX IF NOT EXISTS Tasks_next_fire "
+                                "ON Tasks (user_id, next_fire_at);"));
+    execute(query);
+    query.finish();
+    createSearchIndex();
+
+    // chunks of an import wait here, see stageTasks; the table lives
+    // as long as the connection
+    query = prepareOnce(QString(
+        "CREATE TEMP TABLE IF NOT EXISTS ImportStaging ("
+        "import INTEGER NOT NULL, name TEXT NOT NULL, desc TEXT NOT NULL, "
+        "deadline INTEGER NOT NULL, reminder INTEGER NOT NULL, "
+        "next_fire_at INTEGER NOT NULL);"));
+    execute(query);
+}
+
+void TasksDB::createSearchIndex()
+{
+    // TasksSearch is an FTS5 index over the names and descriptions in
+    // Tasks. It stores no text of its own (content='Tasks'), the
+    // triggers keep it in step with the table. Like the indexes above
+    // it is built when it is missing, e.g. after an upgrade. Without
+    // FTS5 in the SQLite library searchTasks falls back to LIKE.
+
+    QSqlQuery query = prepareOnce(
+        QString("SELECT sqlite_compileoption_used('ENABLE_FTS5');"));
+    if (!execute(query) || !query.next() || !query.value(0).toBool())
+        return;
+    query = prepareOnce(QString(
+        "SELECT name FROM sqlite_master WHERE type = 'table' "
+        "AND name = 'TasksSearch';"));
+    bool missing = execute(query) && !query.next();
+    query.finish();
+
+    const QStringList schema = {
+        "CREATE VIRTUAL TABLE IF NOT EXISTS TasksSearch "
+        "USING fts5(name, desc, content='Tasks', content_rowid='id');",
+        "CREATE TRIGGER IF NOT EXISTS Tasks_search_insert "
+        "AFTER INSERT ON Tasks BEGIN "
+        "INSERT INTO TasksSearch (rowid, name, desc) "
+        "VALUES (new.id, new.name, new.desc); END;",
+        "CREATE TRIGGER IF NOT EXISTS Tasks_search_delete "
+        "AFTER DELETE ON Tasks BEGIN "
+        "INSERT INTO TasksSearch (TasksSearch, rowid, name, desc) "
+        "VALUES ('delete', old.id, old.name, old.desc); END;",
+        // reminder and snooze changes leave the index alone
+        "CREATE TRIGGER IF NOT EXISTS Tasks_search_update "
+        "AFTER UPDATE OF name, desc ON Tasks BEGIN "
+        "INSERT INTO TasksSearch (TasksSearch, rowid, name, desc) "
+        "VALUES ('delete', old.id, old.name, old.desc); "
+        "INSERT INTO TasksSearch (rowid, name, desc) "
+        "VALUES (new.id, new.name, new.desc); END;"
+    };
+    for (const QString &statement : schema) {
+        query = prepareOnce(statement);
+        if (!execute(query))
+            return;
+    }
+    if (missing) {
+        query = prepareOnce(QString(
+            "INSERT INTO TasksSearch (TasksSearch) VALUES ('rebuild');"));
+        if (!execute(query))
+            return;
+    }
+    searchIndex = true;
+}
+
+int TasksDB::schemaVersion() const
+{
+    QSqlQuery query = prepareOnce(QString("PRAGMA user_version;"));
+    if (!execute(query) || !query.next())
+        return -1;
+    return query.value(0).toInt();
+}
+
+void TasksDB::setSchemaVersion(int version) const
+{
+    QSqlQuery query =
+        prepareOnce(QString("PRAGMA user_version = %1;").arg(version));
+    execute(query);
+}
+
+void TasksDB::migrate()
+{
+    // Databases written by older versions of the program are upgraded
+    // in place. The version number is kept in SQLite's user_version
+    // pragma:
+    //   0 - one table per user, times as formatted strings
+    //   1 - one table per user, times as epoch integers
+    //   2 - a single Tasks table keyed by user id
+    //   3 - the next_fire_at column
+    //   4 - reminder and snoozed as integer codes
+    //   5 - unique usernames
+
+    int version = schemaVersion();
+    if (version < 0 || version >= SchemaVersion)
+        return;
+    if (version < 2) {
+        if (!migrateUserTables(version == 0)) {
+            openStatus = Result(Result::DatabaseError,
+                                tr("Cannot upgrade the database to the "
+                                   "current version."));
+            return;
+        }
+    }
+    if (version == 2 || version == 3) {
+        if (!migrateTasksTable()) {
+            openStatus = Result(Result::DatabaseError,
+                                tr("Cannot upgrade the database to the "
+                                   "current version."));
+            return;
+        }
+    }
+    if (!mergeDuplicateUsers()) {
+        openStatus = Result(Result::DatabaseError,
+                            tr("Cannot upgrade the database to the "
+                               "current version."));
+        return;
+    }
+    if (!updateNextFireTimes()) {
+        openStatus = Result(Result::DatabaseError,
+                            tr("Cannot upgrade the database to the "
+                               "current version."));
+        return;
+    }
+    setSchemaVersion(SchemaVersion);
+}
+
+bool TasksDB::migrateUserTables(bool textColumns)
+{
+    // Moves the rows of every per-user table into a new table and
+    // drops the old tables, all in one transaction. The new table is
+    // renamed to Tasks last as a user may have been called "tasks".
+    // Version 0 tables keep their times as strings which are converted
+    // on the way.
+
+    QSqlQuery query =
+        prepareOnce(QString("SELECT id, username FROM Users;"));
+    if (!execute(query))
+        return false;
+    QList<QPair<qint64, QString>> users;
+    while (query.next()) {
+        if (query.value(0) != Invalid && query.value(1) != Invalid)
+            users.append(qMakePair(query.value(0).toLongLong(),
+                                   query.value(1).toString()));
+    }
+    query.finish();
+
+    if (!db.transaction())
+        return false;
+    query = prepareOnce(createTasksTable(UpgradeTable));
+    if (!execute(query)) {
+        db.rollback();
+        return false;
+    }
+    QSqlQuery insert = prepareOnce(
+        QString("INSERT INTO %1 (user_id, name, desc, deadline, reminder, "
+                "created, snoozed, snoozetime) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?);").arg(UpgradeTable));
+    qint64 fallbackCreated = QDateTime::currentMSecsSinceEpoch();
+    for (const auto &user : users) {
+        QSqlQuery select = prepareOnce(
+            QString("SELECT name, desc, deadline, reminder, created, "
+                    "snoozed, snoozetime FROM %1;").arg(user.second));
+        if (!execute(select)) {
+            // the user may have been created without a table
+            continue;
+        }
+        while (select.next()) {
+            insert.bindValue(0, user.first);
+            insert.bindValue(1, select.value(0));
+            insert.bindValue(2, select.value(1));
+            insert.bindValue(4, reminderCode(select.value(3).toString()));
+            insert.bindValue(6, snoozeCode(select.value(5).toString()));
+            if (textColumns) {
+                QDateTime created = QDateTime::fromString(
+                    select.value(4).toString(), "d MMMM yyyy hh:mm:ss.z");
+                insert.bindValue(3, toEpoch(select.value(2).toString()));
+                insert.bindValue(5, created.isValid()
+                                        ? created.toMSecsSinceEpoch()
+                                        : fallbackCreated++);
+                insert.bindValue(7, toEpoch(select.value(6).toString()));
+            } else {
+                insert.bindValue(3, select.value(2).toLongLong());
+                insert.bindValue(5, select.value(4).toLongLong());
+                insert.bindValue(7, select.value(6).toLongLong());
+            }
+            if (!execute(insert)) {
+                db.rollback();
+                return false;
+            }
+        }
+        select.finish();
+        query = prepareOnce(QString("DROP TABLE %1;").arg(user.second));
+        if (!execute(query)) {
+            db.rollback();
+            return false;
+        }
+    }
+    insert.finish();
+    query = prepareOnce(
+        QString("ALTER TABLE %1 RENAME TO Tasks;").arg(UpgradeTable));
+    if (!execute(query)) {
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
+
+bool TasksDB::migrateTasksTable()
+{
+    // SQLite cannot change the type of a column, so the Tasks table of
+    // versions 2 and 3 is copied into a new one with the labels turned
+    // into codes. Its indexes are dropped with it and created again by
+    // createInitialData.
+
+    if (!db.transaction())
+        return false;
+    QStringList statements;
+    statements << createTasksTable(UpgradeTable)
+               << QString("INSERT INTO %1 (id, user_id, name, desc, "
+                          "deadline, reminder, created, snoozed, snoozetime) "
+                          "SELECT id, user_id, name, desc, deadline, %2, "
+                          "created, %3, snoozetime FROM Tasks;")
+                      .arg(UpgradeTable)
+                      .arg(labelsToCodes("reminder", ReminderLabels,
+                                         ReminderCount, NOREMINDER))
+                      .arg(labelsToCodes("snoozed", SnoozeLabels, SnoozeCount,
+                                         NOTSNOOZED))
+               << "DROP TABLE Tasks;"
+               << QString("ALTER TABLE %1 RENAME TO Tasks;").arg(UpgradeTable);
+    for (const QString &statement : statements) {
+        QSqlQuery query = prepareOnce(statement);
+        if (!execute(query)) {
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+bool TasksDB::mergeDuplicateUsers()
+{
+    // Usernames have a unique index since version 5. Older versions
+    // only checked for duplicates in addNewUser, so the tasks of any
+    // duplicate are moved to the first user with that username and
+    // the duplicate is removed before the index is created.
+
+    if (!db.transaction())
+        return false;
+    QStringList statements;
+    statements << "UPDATE Tasks SET user_id = "
+                  "(SELECT MIN(first.id) FROM Users AS first "
+                  "JOIN Users AS owner ON owner.username = first.username "
+                  "WHERE owner.id = Tasks.user_id) "
+                  "WHERE user_id NOT IN "
+                  "(SELECT MIN(id) FROM Users GROUP BY username);"
+               << "DELETE FROM Users WHERE id NOT IN "
+                  "(SELECT MIN(id) FROM Users GROUP BY username);";
+    for (const QString &statement : statements) {
+        QSqlQuery query = prepareOnce(statement);
+        if (!execute(query)) {
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+bool TasksDB::updateNextFireTimes()
+{
+    // The fire times are computed for the tasks which still have a
+    // reminder or a snooze, the others keep the default of 0.
+
+    if (!db.transaction())
+        return false;
+    QSqlQuery query = prepareOnce(
+        QString("SELECT id, deadline, reminder, snoozed, snoozetime "
+                "FROM Tasks WHERE reminder != ? OR snoozed != ?;"));
+    query.bindValue(0, NOREMINDER);
+    query.bindValue(1, NOTSNOOZED);
+    if (!execute(query)) {
+        db.rollback();
+        return false;
+    }
+    QList<QPair<qint64, qint64>> fireTimes;
+    while (query.next()) {
+        fireTimes.append(qMakePair(
+            query.value(0).toLongLong(),
+            nextFireAt(query.value(1).toLongLong(), query.value(2).toInt(),
+                       query.value(3).toInt(),
+                       query.value(4).toLongLong())));
+    }
+    query.finish();
+    QSqlQuery update = prepareOnce(
+        QString("UPDATE Tasks SET next_fire_at = ? WHERE id = ?;"));
+    for (const auto &fireTime : fireTimes) {
+        update.bindValue(0, fireTime.second);
+        update.bindValue(1, fireTime.first);
+        if (!execute(update)) {
+            db.rollback();
+            return false;
+        }
+    }
+    update.finish();
+    return db.commit();
+}
+
+quint64 TasksDB::statementCacheHits() const
+{
+    return cacheHits;
+}
+
+quint64 TasksDB::statementCacheMisses() const
+{
+    return cacheMisses;
+}
+
+qint64 TasksDB::userId(const QString &username) const
+{
+    // user ids never change so they are looked up only once
+    auto it = userIds.constFind(username);
+    if (it != userIds.constEnd())
+        return it.value();
+    QSqlQuery query = prepare(QString("SELECT id FROM Users "
+                                      "WHERE username = ?;"));
+    query.bindValue(0, username);
+    if (!execute(query) || !query.next())
+        return -1;
+    qint64 id = query.value(0).toLongLong();
+    query.finish();
+    userIds.insert(username, id);
+    return id;
+}
+
+qint64 TasksDB::toEpoch(const QString &dateTime)
+{
+    // "d.M.yyyy hh.mm" in local time -> UTC epoch seconds (0 if invalid)
+    QDateTime parsed = QDateTime::fromString(dateTime, "d.M.yyyy hh.mm");
+    if (!parsed.isValid())
+        return 0;
+    return parsed.toMSecsSinceEpoch() / 1000;
+}
+
+QString TasksDB::fromEpoch(qint64 secs)
+{
+    return QDateTime::fromMSecsSinceEpoch(secs * 1000)
+        .toString("d.M.yyyy hh.mm");
+}
+
+QString TasksDB::reminderLabel(int reminder)
+{
+    if (reminder >= 0 && reminder < ReminderCount)
+        return ReminderLabels[reminder];
+    return NoReminderLabel;
+}
+
+QStringList TasksDB::reminderLabels()
+{
+    // in the order of the codes, followed by the label of NOREMINDER
+    QStringList labels;
+    for (int reminder = 0; reminder < ReminderCount; reminder++)
+        labels << ReminderLabels[reminder];
+    return labels << NoReminderLabel;
+}
+
+int TasksDB::reminderCode(const QString &label)
+{
+    for (int reminder = 0; reminder < ReminderCount; reminder++) {
+        if (label == ReminderLabels[reminder])
+            return reminder;
+    }
+    return NOREMINDER;
+}
+
+QString TasksDB::snoozeLabel(int snoozed)
+{
+    if (snoozed >= 0 && snoozed < SnoozeCount)
+        return SnoozeLabels[snoozed];
+    return QString();
+}
+
+QStringList TasksDB::snoozeLabels()
+{
+    QStringList labels;
+    for (int snoozed = 0; snoozed < SnoozeCount; snoozed++)
+        labels << SnoozeLabels[snoozed];
+    return labels;
+}
+
+int TasksDB::snoozeCode(const QString &label)
+{
+    for (int snoozed = 0; snoozed < SnoozeCount; snoozed++) {
+        if (label == SnoozeLabels[snoozed])
+            return snoozed;
+    }
+    return NOTSNOOZED;
+}
+
+qint64 TasksDB::reminderOffset(int reminder)
+{
+    switch (reminder) {
+    case DUE1DAY:
+        return 60 * 60 * 24;
+    case DUE2HRS:
+        return 60 * 60 * 2;
+    case DUE1HR:
+        return 60 * 60;
+    case DUE30MINS:
+        return 60 * 30;
+    case DUE10MINS:
+        return 60 * 10;
+    default:
+        return -1;
+    }
+}
+
+qint64 TasksDB::snoozeWakeup(int snoozed, qint64 deadline, qint64 snoozeTime)
+{
+    // User is able to snooze a task after task's reminder has been
+    // triggered. There are in total 9 different alternatives from which
+    // a user can choose the snooze time depending on the difference
+    // between current time and the actual deadline.
+    switch (snoozed) {
+    case S_5MINSBEFORESTART:
+        return deadline - 5 * 60;
+    case S_10MINSBEFORESTART:
+        return deadline - 10 * 60;
+    case S_5MINS:
+        return snoozeTime + 5 * 60;
+    case S_10MINS:
+        return snoozeTime + 10 * 60;
+    case S_15MINS:
+        return snoozeTime + 15 * 60;
+    case S_30MINS:
+        return snoozeTime + 30 * 60;
+    case S_1HOUR:
+        return snoozeTime + 3600;
+    case S_2HOURS:
+        return snoozeTime + 3600 * 2;
+    case S_4HOURS:
+        return snoozeTime + 3600 * 4;
+    default:
+        return 0;
+    }
+}
+
+qint64 TasksDB::nextFireAt(qint64 deadline, int reminder, int snoozed,
+                           qint64 snoozeTime)
+{
+    // The moment a task next needs attention: when its reminder or
+    // its snooze is due. A reminder takes precedence over a snooze.
+    // Events which would come only after the deadline are replaced by
+    // the first second the task is overdue. Tasks without a reminder
+    // and a snooze never fire.
+    qint64 fire = 0;
+    if (reminder != NOREMINDER) {
+        qint64 offset = reminderOffset(reminder);
+        fire = offset >= 0 ? deadline - offset : 0;
+    } else if (snoozed != NOTSNOOZED) {
+        fire = snoozeWakeup(snoozed, deadline, snoozeTime);
+    } else {
+        return 0;
+    }
+    return fire > 0 && fire < deadline ? fire : deadline + 1;
+}
+
+Result TasksDB::addNewUser(const QString &name,
+                          const QString &username) const
+{
+    if (name.isEmpty())
+        return Result(Result::InvalidArgument,
+                      tr("Name field is empty.\n"
+                         "Please give a proper name for the user."));
+    if (username.isEmpty())
+        return Result(Result::InvalidArgument,
+                      tr("The username cannot be empty.\n"
+                         "Please give a proper username."));
+    // the unique index on username turns a duplicate into an ignored
+    // insert, so no separate lookup is needed
+    QSqlQuery query = prepare(QString("INSERT OR IGNORE INTO Users "
+                                      "(name, username) "
+                                      "VALUES (:name, :username);"));
+    query.bindValue(":name", name);
+    query.bindValue(":username", username);
+    if (!execute(query))
+        return Result(Result::DatabaseError,
+                      tr("Cannot store user %1: %2")
+                          .arg(username)
+                          .arg(query.lastError().text()));
+    if (query.numRowsAffected() == 0)
+        return Result(Result::AlreadyExists,
+                      tr("There already exists user %1.\n"
+                         "Please choose another username")
+                          .arg(username));
+
+    return Result();
+}
+
+qint64 TasksDB::addNewTask(const QString &username, const QString &taskName,
+                           const QString &taskDesc,
+                           const QString &taskDeadline,
+                           int taskReminder,
+                           const QString &taskCreated) const
+{
+    // returns the id of the new task, -1 on failure
+    QSqlQuery query = prepare(QString(
+        "INSERT INTO Tasks "
+        "(user_id, name, desc, deadline, reminder, created, snoozed, "
+        "snoozetime, next_fire_at) "
+        "VALUES (:user_id, :name, :desc, :deadline, "
+        ":reminder, :created, :snoozed, :snoozetime, :next_fire_at);"));
+    query.bindValue(":user_id", userId(username));
+    query.bindValue(":name", taskName);
+    query.bindValue(":desc", taskDesc);
+    query.bindValue(":deadline", toEpoch(taskDeadline));
+    query.bindValue(":reminder", taskReminder);
+    query.bindValue(":created", taskCreated.toLongLong());
+    query.bindValue(":snoozed", NOTSNOOZED);
+    query.bindValue(":snoozetime", 0);
+    query.bindValue(":next_fire_at", nextFireAt(toEpoch(taskDeadline),
+                                                taskReminder, NOTSNOOZED, 0));
+    if (!execute(query))
+        return -1;
+    return query.lastInsertId().toLongLong();
+}
+
+QStringList TasksDB::findUsers(const QString &prefix, int limit) const
+{
+    // Returns at most limit usernames (all of them when negative) which
+    // start with prefix, in order. The prefix becomes a range of the
+    // unique index on username: everything from prefix up to prefix
+    // followed by the highest code point.
+    QSqlQuery query = prepare(QString("SELECT username FROM Users "
+                                      "WHERE username >= ? AND username < ? "
+                                      "ORDER BY username LIMIT ?;"));
+    uint highest = 0x10FFFF;
+    query.bindValue(0, prefix);
+    query.bindValue(1, prefix + QString::fromUcs4(&highest, 1));
+    query.bindValue(2, limit);
+    QStringList usernames;
+    if (!execute(query))
+        return usernames;
+    while (query.next()) {
+        if (query.value(0) != Invalid)
+            usernames << query.value(0).toString();
+    }
+    return usernames;
+}
+
+Result TasksDB::hasUser(const QString &name, const QString &username) const
+{
+    QSqlQuery query = prepare(QString("SELECT id, username FROM Users "
+                                      "WHERE name = ? AND username = ?;"));
+    query.bindValue(0, name);
+    query.bindValue(1, username);
+    if (!execute(query))
+        return Result(Result::DatabaseError, query.lastError().text());
+
+    bool found = query.next() && query.value(0) != Invalid &&
+                 query.value(1) != Invalid;
+    query.finish();
+    if (found)
+        return Result();
+    return Result(Result::NotFound,
+                  tr("The database does not contain user (%1, %2).\n"
+                     "Please choose an existing user.")
+                      .arg(name)
+                      .arg(username));
+}
+
+Tasks TasksDB::getTasks(const QString &username, qint64 afterId,
+                        int limit) const
+{
+    // Returns at most limit tasks (all of them when negative) whose id
+    // is greater than afterId, in id order. Paging on the id instead of
+    // an OFFSET keeps every page a range scan of (user_id, id).
+
+    QSqlQuery query = prepare(
+        QString("SELECT id, name, desc, deadline, reminder, snoozed, "
+                "snoozetime FROM Tasks "
+                "WHERE user_id = ? AND id > ? ORDER BY id LIMIT ?;"));
+    query.bindValue(0, userId(username));
+    query.bindValue(1, afterId);
+    query.bindValue(2, limit);
+    return readTasks(query);
+}
+
+Tasks TasksDB::getTasksByDeadline(const QString &username,
+                                  qint64 afterDeadline, qint64 afterId,
+                                  int limit) const
+{
+    // Like getTasks, but in (deadline, id) order: the page after the
+    // task with afterDeadline and afterId. The order is that of the
+    // Tasks_user_deadline index (whose entries end with the id), so
+    // SQLite reads the page from the index without sorting anything.
+
+    QSqlQuery query = prepare(
+        QString("SELECT id, name, desc, deadline, reminder, snoozed, "
+                "snoozetime FROM Tasks "
+                "WHERE user_id = ? AND deadline >= ? "
+                "AND (deadline > ? OR id > ?) "
+                "ORDER BY deadline, id LIMIT ?;"));
+    query.bindValue(0, userId(username));
+    query.bindValue(1, afterDeadline);
+    query.bindValue(2, afterDeadline);
+    query.bindValue(3, afterId);
+    query.bindValue(4, limit);
+    return readTasks(query);
+}
+
+Tasks TasksDB::readTasks(QSqlQuery &query) const
+{
+    // the rows of the task listings above
+    Tasks tasks;
+    if (!execute(query)) {
+        return tasks;
+    }
+    while (query.next()) {
+        if (query.value(0) != Invalid && query.value(1) != Invalid &&
+            query.value(2) != Invalid && query.value(3) != Invalid &&
+            query.value(4) != Invalid && query.value(5) != Invalid &&
+            query.value(6) != Invalid) {
+            Task task;
+            task.id = query.value(0).toLongLong();
+            task.name = query.value(1).toString();
+            task.desc = query.value(2).toString();
+            task.deadline = query.value(3).toLongLong();
+            task.reminder = query.value(4).toInt();
+            task.snoozed = query.value(5).toInt();
+            task.snoozeTime = query.value(6).toLongLong();
+            tasks.append(task);
+        }
+    }
+    return tasks;
+}
+
+QVector<qint64> TasksDB::searchTasks(const QString &username,
+                                     const QString &text, int limit) const
+{
+    // Returns the ids of the user's tasks in which every word of text
+    // starts a word of the name or the description, at most limit of
+    // them (all when negative). With the FTS5 index the best matches
+    // (bm25) come first, otherwise the tasks are in id order.
+
+    QVector<qint64> ids;
+    QStringList words =
+        text.split(QRegularExpression("\\W+",
+                                      QRegularExpression::
+                                          UseUnicodePropertiesOption),
+                   QString::SkipEmptyParts);
+    if (words.isEmpty())
+        return ids;
+    QSqlQuery query;
+    if (searchIndex) {
+        // quoted, so that words like AND or NEAR are not operators
+        for (QString &word : words)
+            word = QString("\"%1\"*").arg(word);
+        query = prepare(QString(
+            "SELECT Tasks.id FROM TasksSearch "
+            "JOIN Tasks ON Tasks.id = TasksSearch.rowid "
+            "WHERE TasksSearch MATCH ? AND Tasks.user_id = ? "
+            "ORDER BY TasksSearch.rank LIMIT ?;"));
+        query.bindValue(0, words.join(' '));
+        query.bindValue(1, userId(username));
+        query.bindValue(2, limit);
+    } else {
+        // the words are only matched at the start of the texts here
+        QString condition = "(name LIKE ? OR desc LIKE ?)";
+        QStringList conditions;
+        for (int i = 0; i < words.size(); i++)
+            conditions << condition;
+        query = prepare(QString("SELECT id FROM Tasks WHERE user_id = ? "
+                                "AND %1 ORDER BY id LIMIT ?;")
+                            .arg(conditions.join(" AND ")));
+        int i = 0;
+        query.bindValue(i++, userId(username));
+        for (const QString &word : words) {
+            query.bindValue(i++, word + "%");
+            query.bindValue(i++, word + "%");
+        }
+        query.bindValue(i, limit);
+    }
+    if (!execute(query))
+        return ids;
+    while (query.next()) {
+        if (query.value(0) != Invalid)
+            ids.append(query.value(0).toLongLong());
+    }
+    return ids;
+}
+
+QStringList TasksDB::getTask(const QString &username, qint64 id) const
+{
+    QSqlQuery query =
+        prepare(QString("SELECT name, desc, deadline, reminder FROM Tasks "
+                        "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, id);
+    query.bindValue(1, userId(username));
+    QStringList task;
+    if (!execute(query)) {
+        return task;
+    } else {
+        query.next();
+        if (query.value(0) != Invalid && query.value(1) != Invalid &&
+            query.value(2) != Invalid && query.value(3) != Invalid) {
+            task << query.value(0).toString() << query.value(1).toString()
+                 << fromEpoch(query.value(2).toLongLong())
+                 << reminderLabel(query.value(3).toInt());
+        }
+        query.finish();
+        return task;
+    }
+}
+
+void TasksDB::updateTask(const QString &username, qint64 id,
+                         const QString &taskname, const QString &taskdesc,
+                         const QString &taskdeadline, int reminder) const
+{
+    // the snooze state is kept, the next fire time depends on it too
+    qint64 owner = userId(username);
+    QSqlQuery query = prepare(QString("SELECT snoozed, snoozetime FROM Tasks "
+                                      "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, id);
+    query.bindValue(1, owner);
+    if (!execute(query) || !query.next())
+        return;
+    int snoozed = query.value(0).toInt();
+    qint64 snoozeTime = query.value(1).toLongLong();
+    query.finish();
+
+    qint64 deadline = toEpoch(taskdeadline);
+    query = prepare(QString("UPDATE Tasks SET name = ?, desc = ?, "
+                            "deadline = ?, reminder = ?, next_fire_at = ? "
+                            "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, taskname);
+    query.bindValue(1, taskdesc);
+    query.bindValue(2, deadline);
+    query.bindValue(3, reminder);
+    query.bindValue(4, nextFireAt(deadline, reminder, snoozed, snoozeTime));
+    query.bindValue(5, id);
+    query.bindValue(6, owner);
+    execute(query);
+}
+
+void TasksDB::deleteTask(const QString &username, qint64 id) const
+{
+    QSqlQuery query;
+    query = prepare(QString("DELETE FROM Tasks "
+                            "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, id);
+    query.bindValue(1, userId(username));
+    execute(query);
+}
+
+Result TasksDB::exportToFile(const QString &username,
+                             const QString &fileName, FileFormat format,
+                             int *count) const
+{
+    // count is set to the number of exported tasks
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        return Result(Result::FileError,
+                      tr("Cannot open file %1 for writing: %2")
+                          .arg(fileName)
+                          .arg(file.errorString()));
+    // tasks which have already past the due are not exported
+    QSqlQuery query = prepare(
+        QString("SELECT name, desc, deadline, reminder "
+                "FROM Tasks WHERE user_id = ? AND deadline >= ?;"));
+    query.bindValue(0, userId(username));
+    query.bindValue(1, QDateTime::currentMSecsSinceEpoch() / 1000);
+    if (!execute(query)) {
+        file.close();
+        return Result(Result::DatabaseError, query.lastError().text());
+    }
+    int exported = 0;
+    bool written;
+    if (format == BinaryFile) {
+        BinaryTaskWriter writer(&file);
+        Task task;
+        while (query.next()) {
+            if (query.value(0) != Invalid && query.value(1) != Invalid &&
+                query.value(2) != Invalid && query.value(3) != Invalid) {
+                task.name = query.value(0).toString();
+                task.desc = query.value(1).toString();
+                task.deadline = query.value(2).toLongLong();
+                task.reminder = query.value(3).toInt();
+                writer.append(task);
+            }
+        }
+        written = writer.finish();
+        exported = writer.count();
+    } else {
+        QTextStream out(&file);
+        out.setCodec("UTF-8");
+        out << MagicNumber() << "\n";
+        while (query.next()) {
+            if (query.value(0) != Invalid && query.value(1) != Invalid &&
+                query.value(2) != Invalid && query.value(3) != Invalid) {
+                out << query.value(0).toString() << "\n";
+                out << query.value(1).toString() << "\n";
+                out << fromEpoch(query.value(2).toLongLong()) << "\n";
+                out << reminderLabel(query.value(3).toInt()) << "\n";
+                out << "\n";
+                exported++;
+            }
+        }
+        out.flush();
+        written = out.status() == QTextStream::Ok;
+    }
+    file.close();
+    if (count)
+        *count = exported;
+    if (!written)
+        return Result(Result::FileError,
+                      tr("Cannot write tasks to file %1.").arg(fileName));
+    return Result();
+}
+
+ImportReport TasksDB::importFromFile(const QString &username,
+                                     const QString &fileName) const
+{
+    // Text records are parsed and validated one at a time and stored
+    // right away with one prepared statement inside a single
+    // transaction, so memory use does not depend on the size of the
+    // file. Parsing goes on after a bad record to collect every
+    // problem, but then the transaction is rolled back and nothing is
+    // imported. Binary files are read whole and stored with
+    // importTasks.
+
+    ImportReport report;
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        report.errorCount = 1;
+        report.errors << tr("Cannot open file %1 for reading: %2")
+                             .arg(fileName)
+                             .arg(file.errorString());
+        return report;
+    }
+    if (BinaryTaskReader::isBinary(&file)) {
+        BinaryTaskReader reader(&file);
+        if (reader.read())
+            return importTasks(username, reader.tasks());
+        report.errorCount = 1;
+        report.errors << reader.errorString();
+        return report;
+    }
+    TaskFileParser parser(&file);
+    if (!parser.readHeader()) {
+        report.errorCount = parser.errorCount();
+        report.errors = parser.errors();
+        return report;
+    }
+
+    // QSqlDatabase is a handle, the copy refers to the same connection
+    QSqlDatabase connection = db;
+    QElapsedTimer timer;
+    timer.start();
+    if (!connection.transaction()) {
+        report.errorCount = 1;
+        report.errors << connection.lastError().text();
+        return report;
+    }
+    QSqlQuery query = prepareImport();
+    qint64 owner = userId(username);
+    qint64 created = QDateTime::currentMSecsSinceEpoch();
+    bool stored = true;
+    TaskRecord record;
+    Task task;
+    while (parser.next(record)) {
+        if (!stored || parser.errorCount() > 0)
+            continue;
+        task.name = record.name;
+        task.desc = record.desc;
+        task.deadline = toEpoch(record.deadline);
+        task.reminder = reminderCode(record.reminder);
+        if (importTask(query, owner, task, created)) {
+            if (report.imported++ == 0)
+                report.firstId = query.lastInsertId().toLongLong();
+        } else {
+            stored = false;
+            report.errors << tr("Line %1: the task could not be stored: %2")
+                                 .arg(record.line)
+                                 .arg(query.lastError().text());
+        }
+    }
+    query.finish();
+    report.errorCount = parser.errorCount() + (stored ? 0 : 1);
+    report.errors = parser.errors() + report.errors;
+    finishImport(report, timer);
+    return report;
+}
+
+ImportReport TasksDB::importTasks(const QString &username,
+                                  const Tasks &tasks) const
+{
+    // Stores tasks which have already been read and checked, e.g. from
+    // a binary file, in one transaction. Only name, description,
+    // deadline and reminder of the tasks are used.
+
+    ImportReport report;
+    QSqlDatabase connection = db;
+    QElapsedTimer timer;
+    timer.start();
+    if (!connection.transaction()) {
+        report.errorCount = 1;
+        report.errors << connection.lastError().text();
+        return report;
+    }
+    QSqlQuery query = prepareImport();
+    qint64 owner = userId(username);
+    qint64 created = QDateTime::currentMSecsSinceEpoch();
+    for (const Task &task : tasks) {
+        if (!importTask(query, owner, task, created)) {
+            report.errorCount = 1;
+            report.errors << tr("Record %1: the task could not be stored: %2")
+                                 .arg(report.imported + 1)
+                                 .arg(query.lastError().text());
+            break;
+        }
+        if (report.imported++ == 0)
+            report.firstId = query.lastInsertId().toLongLong();
+    }
+    query.finish();
+    finishImport(report, timer);
+    return report;
+}
+
+bool TasksDB::stageTasks(int import, const Tasks &tasks) const
+{
+    // The staged tasks wait in ImportStaging, a temporary table of this
+    // connection. Writing it locks nothing in the database file, so
+    // the chunks of several files can come in between the other calls.
+    if (!transaction())
+        return false;
+    QSqlQuery query =
+        prepare(QString("INSERT INTO ImportStaging (import, name, desc, "
+                        "deadline, reminder, next_fire_at) "
+                        "VALUES (?, ?, ?, ?, ?, ?);"));
+    for (const Task &task : tasks) {
+        query.bindValue(0, import);
+        query.bindValue(1, task.name);
+        query.bindValue(2, task.desc);
+        query.bindValue(3, task.deadline);
+        query.bindValue(4, task.reminder);
+        query.bindValue(5, nextFireAt(task.deadline, task.reminder,
+                                      NOTSNOOZED, 0));
+        if (!execute(query)) {
+            QSqlDatabase connection = db;
+            connection.rollback();
+            return false;
+        }
+    }
+    return commit();
+}
+
+ImportReport TasksDB::importStaged(const QString &username, int import) const
+{
+    // Moves the staged tasks into Tasks in staging order with one
+    // statement, so their ids follow each other.
+    ImportReport report;
+    QSqlDatabase connection = db;
+    QElapsedTimer timer;
+    timer.start();
+    if (!connection.transaction()) {
+        report.errorCount = 1;
+        report.errors << connection.lastError().text();
+        return report;
+    }
+    QSqlQuery query = prepare(QString(
+        "INSERT INTO Tasks (user_id, name, desc, deadline, reminder, "
+        "created, snoozed, snoozetime, next_fire_at) "
+        "SELECT ?, name, desc, deadline, reminder, ?, ?, 0, next_fire_at "
+        "FROM ImportStaging WHERE import = ? ORDER BY rowid;"));
+    query.bindValue(0, userId(username));
+    query.bindValue(1, QDateTime::currentMSecsSinceEpoch());
+    query.bindValue(2, NOTSNOOZED);
+    query.bindValue(3, import);
+    if (execute(query)) {
+        report.imported = query.numRowsAffected();
+        if (report.imported > 0)
+            report.firstId =
+                query.lastInsertId().toLongLong() - report.imported + 1;
+    } else {
+        report.errorCount = 1;
+        report.errors << tr("The tasks could not be stored: %1")
+                             .arg(query.lastError().text());
+    }
+    query.finish();
+    finishImport(report, timer);
+    dropStaged(import);
+    return report;
+}
+
+void TasksDB::dropStaged(int import) const
+{
+    QSqlQuery query =
+        prepare(QString("DELETE FROM ImportStaging WHERE import = ?;"));
+    query.bindValue(0, import);
+    execute(query);
+}
+
+QSqlQuery TasksDB::prepareImport() const
+{
+    return prepare(QString("INSERT INTO Tasks "
+                           "(user_id, name, desc, deadline, reminder, "
+                           "created, snoozed, snoozetime, next_fire_at) "
+                           "VALUES (:user_id, :name, :desc, :deadline, "
+                           ":reminder, :created, :snoozed, :snoozetime, "
+                           ":next_fire_at);"));
+}
+
+bool TasksDB::importTask(QSqlQuery &query, qint64 owner, const Task &task,
+                         qint64 created) const
+{
+    // stores one imported task with the statement from prepareImport
+    query.bindValue(":user_id", owner);
+    query.bindValue(":name", task.name);
+    query.bindValue(":desc", task.desc);
+    query.bindValue(":deadline", task.deadline);
+    query.bindValue(":reminder", task.reminder);
+    query.bindValue(":created", created);
+    query.bindValue(":snoozed", NOTSNOOZED);
+    query.bindValue(":snoozetime", 0);
+    query.bindValue(":next_fire_at",
+                    nextFireAt(task.deadline, task.reminder, NOTSNOOZED, 0));
+    return execute(query);
+}
+
+void TasksDB::finishImport(ImportReport &report,
+                           const QElapsedTimer &timer) const
+{
+    // commits the transaction of an import without problems, anything
+    // else is rolled back so that nothing of the file is imported
+    QSqlDatabase connection = db;
+    if (report.errorCount == 0 && !connection.commit()) {
+        report.errorCount = 1;
+        report.errors << connection.lastError().text();
+    }
+    if (report.errorCount > 0) {
+        connection.rollback();
+        report.imported = 0;
+        report.firstId = 0;
+        return;
+    }
+    report.elapsed = timer.elapsed();
+}
+
+ReminderCheck TasksDB::checkReminders(const QString &username) const
+{
+    // Evaluates every reminder rule in one pass over the user's tasks,
+    // see checkReminder. Only the tasks whose next_fire_at has come (in
+    // this minute) are read. The overdue tasks are dismissed here.
+    ReminderCheck check;
+    if (username.isEmpty())
+        return check;
+    qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+    QSqlQuery query = prepare(
+        QString("SELECT id, name, deadline, reminder, snoozed, next_fire_at "
+                "FROM Tasks "
+                "WHERE user_id = ? AND next_fire_at BETWEEN 1 AND ?;"));
+    query.bindValue(0, userId(username));
+    query.bindValue(1, currentTime / 60 * 60 + 59);
+    if (!execute(query))
+        return check;
+    while (query.next()) {
+        if (query.value(0) == Invalid || query.value(1) == Invalid ||
+            query.value(2) == Invalid || query.value(3) == Invalid ||
+            query.value(4) == Invalid || query.value(5) == Invalid)
+            continue;
+        Task task;
+        task.id = query.value(0).toLongLong();
+        task.name = query.value(1).toString();
+        task.deadline = query.value(2).toLongLong();
+        task.reminder = query.value(3).toInt();
+        task.snoozed = query.value(4).toInt();
+        checkReminder(task, query.value(5).toLongLong(), currentTime, &check);
+    }
+    query.finish();
+
+    if (!check.overdue.isEmpty()) {
+        QSqlDatabase connection = db;
+        connection.transaction();
+        for (const Reminder &reminder : check.overdue)
+            dismissReminder(username, reminder.id);
+        connection.commit();
+    }
+    return check;
+}
+
+void TasksDB::checkReminder(const Task &task, qint64 fireAt,
+                            qint64 currentTime, ReminderCheck *check)
+{
+    // Adds the task to check if it needs attention now that its fire
+    // time (see nextFireAt) has come. A task is reported at most once,
+    // as
+    //  - due:     the reminder time of the task is this minute
+    //  - snoozed: a snooze wakes up this minute
+    //  - overdue: the deadline has passed but the task still has a
+    //             reminder or a snooze; the caller dismisses those and
+    //             the program marks the tasks in red
+    //  - pending: the deadline is ahead but the reminder or snooze
+    //             time has already passed, e.g. while the program was
+    //             not running
+    Reminder reminder;
+    reminder.id = task.id;
+    reminder.name = task.name;
+    reminder.deadline = task.deadline;
+    reminder.snoozed = task.snoozed;
+    qint64 deadline = task.deadline;
+
+    if (deadline < currentTime) {
+        reminder.dueIn = "Overdue: " + durationText(currentTime - deadline);
+        check->overdue.append(reminder);
+    } else if (fireAt < deadline && fireAt / 60 == currentTime / 60) {
+        // reminders and snoozes are matched with minute resolution,
+        // a fire time after the deadline only marks it as overdue
+        if (task.reminder != NOREMINDER) {
+            reminder.dueIn = dueText(deadline - fireAt);
+            check->due.append(reminder);
+        } else {
+            if (task.snoozed == S_5MINSBEFORESTART ||
+                task.snoozed == S_10MINSBEFORESTART)
+                reminder.dueIn = dueText(deadline - fireAt);
+            else
+                reminder.dueIn = durationText(currentTime - deadline);
+            check->snoozed.append(reminder);
+        }
+    } else if (deadline > currentTime && fireAt + 60 < currentTime) {
+        // pending a minute after the reminder or the snooze was due
+        reminder.dueIn = durationText(deadline - currentTime);
+        check->pending.append(reminder);
+    }
+}
+
+void TasksDB::dismissReminder(const QString &username, qint64 id) const
+{
+    QSqlQuery query = prepare(QString("UPDATE Tasks SET reminder = ?, "
+                                      "snoozed = ?, snoozetime = ?, "
+                                      "next_fire_at = 0 "
+                                      "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, NOREMINDER);
+    query.bindValue(1, NOTSNOOZED);
+    query.bindValue(2, 0);
+    query.bindValue(3, id);
+    query.bindValue(4, userId(username));
+    execute(query);
+}
+
+void TasksDB::setSnoozeForTask(const QString &username, qint64 id,
+                               int snoozed, const QString &time) const
+{
+    // a snooze replaces the reminder of the task, which would otherwise
+    // come first in nextFireAt
+    qint64 owner = userId(username);
+    QSqlQuery query = prepare(QString("SELECT deadline FROM Tasks "
+                                      "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, id);
+    query.bindValue(1, owner);
+    if (!execute(query) || !query.next())
+        return;
+    qint64 deadline = query.value(0).toLongLong();
+    query.finish();
+
+    qint64 snoozeTime = toEpoch(time);
+    query = prepare(QString("UPDATE Tasks SET reminder = ?, snoozed = ?, "
+                            "snoozetime = ?, next_fire_at = ? "
+                            "WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, NOREMINDER);
+    query.bindValue(1, snoozed);
+    query.bindValue(2, snoozeTime);
+    query.bindValue(3, nextFireAt(deadline, NOREMINDER, snoozed, snoozeTime));
+    query.bindValue(4, id);
+    query.bindValue(5, owner);
+    execute(query);
+}
+
+Result TasksDB::exportTask(const QString &username, qint64 id,
+                          const QString &fileName) const
+{
+    // Writes a single task in the import file format, this is how a
+    // task is sent to another user. Tasks which are already past their
+    // deadline are not exported.
+    QSqlQuery query =
+        prepare(QString("SELECT name, desc, deadline, reminder "
+                        "FROM Tasks WHERE id = ? AND user_id = ?;"));
+    query.bindValue(0, id);
+    query.bindValue(1, userId(username));
+    if (!execute(query))
+        return Result(Result::DatabaseError, query.lastError().text());
+    bool found = query.next() && query.value(0) != Invalid &&
+                 query.value(1) != Invalid && query.value(2) != Invalid &&
+                 query.value(3) != Invalid;
+    QString name = query.value(0).toString();
+    QString desc = query.value(1).toString();
+    qint64 deadline = query.value(2).toLongLong();
+    int reminder = query.value(3).toInt();
+    query.finish();
+    if (!found)
+        return Result(Result::NotFound, tr("The task does not exist."));
+    if (QDateTime::currentMSecsSinceEpoch() / 1000 >= deadline)
+        return Result(Result::InvalidArgument,
+                      tr("Task %1 is already past its deadline.").arg(name));
+
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        return Result(Result::FileError,
+                      tr("Cannot open file %1 for writing: %2")
+                          .arg(fileName)
+                          .arg(file.errorString()));
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << MagicNumber() << "\n";
+    out << name << "\n";
+    out << desc << "\n";
+    out << fromEpoch(deadline) << "\n";
+    out << reminderLabel(reminder) << "\n";
+    out << "\n";
+    out.flush();
+    if (out.status() != QTextStream::Ok)
+        return Result(Result::FileError,
+                      tr("Cannot write the task to file %1.").arg(fileName));
+    return Result();
+}
@@ -0,0 +1,203 @@
+/**
+  * This interface class provides storage for
+  * all the users data and handles required
+  * actions. It does not interact with the user,
+  * failures are returned as a Result or, for the
+  * operations without one, reported with the
+  * databaseError signal. An instance must only be
+  * used in the thread which created it, see
+  * AsyncTasksDB for use from the GUI.
+  *
+**/
+
+#ifndef TASKSDB_H
+#define TASKSDB_H
+
+#include <QObject>
+#include <QtSql/QSqlDatabase>
+#include <QVariant>
+#include <QtSql/QSqlQuery>
+#include <QList>
+#include <QStringList>
+#include <QHash>
+#include <QCache>
+#include "task.h"
+#include "result.h"
+
+class QElapsedTimer;
+
+constexpr quint32 MagicNumber()
+{
+    return 0x21091983;
+}
+
+struct ImportReport
+{
+    int imported = 0;
+    // number of problems found, errors holds (at most) the first ones
+    int errorCount = 0;
+    QStringList errors;
+    // milliseconds spent storing the tasks
+    qint64 elapsed = 0;
+    // the id of the first imported task, the others follow it
+    qint64 firstId = 0;
+
+    qint64 rowsPerSecond() const
+    {
+        return imported * 1000 / qMax(elapsed, qint64(1));
+    }
+};
+
+// SQLite settings applied when a connection is opened. Empty texts
+// keep SQLite's defaults.
+struct ConnectionOptions
+{
+    // in WAL mode a commit appends to the log instead of rewriting a
+    // rollback journal, with synchronous = NORMAL it is only synced at
+    // checkpoints
+    QString journalMode = "WAL";
+    QString synchronous = "NORMAL";
+    // pages, or KiB when negative
+    int cacheSize = -8000;
+    qint64 mmapSize = 64 * 1024 * 1024;
+    // milliseconds to wait for a lock held by another connection
+    int busyTimeout = 5000;
+    // AsyncTasksDB commits the single-task writes in groups, at most
+    // this many milliseconds after the first one; 0 commits every
+    // write right away
+    int writeBehind = 0;
+};
+
+class TasksDB : public QObject
+{
+    Q_OBJECT
+    Q_ENUMS(Reminders)
+    Q_ENUMS(Snoozed)
+  public:
+    explicit TasksDB(const QString &databaseName = QString(),
+                     const ConnectionOptions &options = ConnectionOptions(),
+                     QObject *parent = 0);
+    ~TasksDB();
+
+    // whether the database could be opened and set up
+    Result status() const;
+    // groups the following calls into one transaction, failures are
+    // reported with databaseError
+    bool transaction() const;
+    bool commit() const;
+
+    // The reminder and snooze columns store these codes, the labels
+    // ("2 hrs", "5 mins before start") are only used for showing them
+    // and in task files, see reminderLabel and snoozeLabel.
+    enum Reminders {
+        NOREMINDER = -1,
+        DUE1DAY,
+        DUE2HRS,
+        DUE1HR,
+        DUE30MINS,
+        DUE10MINS
+    };
+
+    enum Snoozed {
+        NOTSNOOZED = -1,
+        S_5MINSBEFORESTART,
+        S_10MINSBEFORESTART,
+        S_5MINS,
+        S_10MINS,
+        S_15MINS,
+        S_30MINS,
+        S_1HOUR,
+        S_2HOURS,
+        S_4HOURS
+    };
+
+    // importFromFile recognizes both formats by their first bytes, see
+    // TaskFileParser and BinaryTaskReader
+    enum FileFormat { TextFile, BinaryFile };
+
+    Result addNewUser(const QString &, const QString &) const;
+    Result hasUser(const QString &, const QString &) const;
+    QStringList findUsers(const QString &, int limit = -1) const;
+    Tasks getTasks(const QString &, qint64 afterId = 0, int limit = -1) const;
+    Tasks getTasksByDeadline(const QString &, qint64, qint64,
+                             int limit = -1) const;
+    qint64 addNewTask(const QString &, const QString &, const QString &,
+                      const QString &, int, const QString &) const;
+    void updateTask(const QString &, qint64, const QString &, const QString &,
+                    const QString &, int) const;
+    void deleteTask(const QString &, qint64) const;
+    QStringList getTask(const QString &, qint64) const;
+    QVector<qint64> searchTasks(const QString &, const QString &,
+                                int limit = -1) const;
+    ImportReport importFromFile(const QString &, const QString &) const;
+    ImportReport importTasks(const QString &, const Tasks &) const;
+    // A file too big for one call is imported in chunks: they are
+    // staged under a number of the caller's choice and then stored in
+    // one transaction by importStaged, or dropped.
+    bool stageTasks(int, const Tasks &) const;
+    ImportReport importStaged(const QString &, int) const;
+    void dropStaged(int) const;
+    Result exportToFile(const QString &, const QString &,
+                        FileFormat format = TextFile, int *count = 0) const;
+    ReminderCheck checkReminders(const QString &) const;
+    void dismissReminder(const QString &, qint64) const;
+    // the snooze replaces the task's reminder
+    void setSnoozeForTask(const QString &, qint64, int,
+                          const QString &) const;
+    Result exportTask(const QString &, qint64, const QString &) const;
+
+    quint64 statementCacheHits() const;
+    quint64 statementCacheMisses() const;
+
+    static qint64 toEpoch(const QString &);
+    static QString fromEpoch(qint64);
+    static QString reminderLabel(int);
+    static QStringList reminderLabels();
+    // NOREMINDER for labels which are not known
+    static int reminderCode(const QString &);
+    static QString snoozeLabel(int);
+    static QStringList snoozeLabels();
+    // NOTSNOOZED for labels which are not known
+    static int snoozeCode(const QString &);
+    // seconds before the deadline at which a reminder fires, -1 for none
+    static qint64 reminderOffset(int);
+    // the epoch second at which a snooze wakes up, 0 for none
+    static qint64 snoozeWakeup(int, qint64, qint64);
+    static qint64 nextFireAt(qint64, int, int, qint64);
+    // sorts a task whose fire time has come into the check
+    static void checkReminder(const Task &, qint64, qint64, ReminderCheck *);
+
+signals:
+    void databaseError(const QString &message) const;
+
+  private:
+    QSqlQuery prepare(const QString &statement) const;
+    QSqlQuery prepareOnce(const QString &statement) const;
+    bool execute(QSqlQuery &query) const;
+    void createConnection(const QString &, const ConnectionOptions &);
+    void createInitialData();
+    int schemaVersion() const;
+    void setSchemaVersion(int) const;
+    void migrate();
+    bool migrateUserTables(bool);
+    bool migrateTasksTable();
+    bool mergeDuplicateUsers();
+    bool updateNextFireTimes();
+    void createSearchIndex();
+    Tasks readTasks(QSqlQuery &) const;
+    QSqlQuery prepareImport() const;
+    bool importTask(QSqlQuery &, qint64, const Task &, qint64) const;
+    void finishImport(ImportReport &, const QElapsedTimer &) const;
+    qint64 userId(const QString &) const;
+    const QVariant Invalid;
+    QSqlDatabase db;
+    Result openStatus;
+    // whether TasksSearch can be used, see createSearchIndex
+    bool searchIndex;
+    mutable QHash<QString, qint64> userIds;
+    mutable QCache<QString, QSqlQuery> statements;
+    mutable quint64 cacheHits;
+    mutable quint64 cacheMisses;
+};
+
+#endif // TASKSDB_H
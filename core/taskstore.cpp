@@ -0,0 +1,277 @@
+#include "taskstore.h"
+#include "asynctasksdb.h"
+#include <QDateTime>
+#include <QPair>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+// the number of tasks read from the database in one call
+const int LoadPageSize = 5000;
+}
+
+TaskStore::TaskStore(AsyncTasksDB *tasksDB, QObject *parent)
+    : QObject(parent), tasksDB(tasksDB), loaded(false), generation(0)
+{
+    connect(tasksDB, SIGNAL(writesLost()), this, SLOT(reload()));
+}
+
+void TaskStore::clear()
+{
+    username.clear();
+    loaded = false;
+    generation++;
+    tasks.clear();
+    fireTimes.clear();
+    fireDeadlines.clear();
+    emit reset();
+}
+
+void TaskStore::load(const QString &user)
+{
+    clear();
+    username = user;
+    loadPage(generation, std::numeric_limits<qint64>::min(), 0);
+}
+
+void TaskStore::loadPage(int load, qint64 afterDeadline, qint64 afterId)
+{
+    // The tasks are read in pages in deadline order, each page goes on
+    // from the last task of the one before (see getTasksByDeadline).
+    // The calls queued in between, e.g. a search, do not have to wait
+    // for the whole account to be read, and every page is shown as
+    // soon as it is in memory.
+    whenFinished(tasksDB->getTasksByDeadline(username, afterDeadline, afterId,
+                                             LoadPageSize),
+                 this, [=](const Tasks &page) {
+        if (load != generation)
+            return;
+        QVector<qint64> added;
+        added.reserve(page.size());
+        for (const Task &task : page) {
+            // a task added during the load may be there already
+            if (!tasks.contains(task.id)) {
+                insert(task);
+                added.append(task.id);
+            }
+        }
+        if (!added.isEmpty())
+            emit tasksAdded(added);
+        if (page.size() == LoadPageSize) {
+            loadPage(load, page.last().deadline, page.last().id);
+            return;
+        }
+        loaded = true;
+        emit loadFinished();
+    });
+}
+
+void TaskStore::reload()
+{
+    if (!username.isEmpty())
+        load(username);
+}
+
+QString TaskStore::user() const
+{
+    return username;
+}
+
+bool TaskStore::isLoaded() const
+{
+    return loaded;
+}
+
+int TaskStore::size() const
+{
+    return tasks.size();
+}
+
+bool TaskStore::contains(qint64 id) const
+{
+    return tasks.contains(id);
+}
+
+const Task &TaskStore::task(qint64 id) const
+{
+    Q_ASSERT(tasks.contains(id));
+    return *tasks.constFind(id);
+}
+
+QVector<qint64> TaskStore::ids() const
+{
+    QVector<QPair<qint64, qint64> > order;
+    order.reserve(tasks.size());
+    for (auto it = tasks.constBegin(); it != tasks.constEnd(); ++it)
+        order.append(qMakePair(it->deadline, it.key()));
+    std::sort(order.begin(), order.end());
+    QVector<qint64> ids;
+    ids.reserve(order.size());
+    for (const auto &task : order)
+        ids.append(task.second);
+    return ids;
+}
+
+QFuture<qint64> TaskStore::addTask(const Task &task, const QString &created)
+{
+    QFuture<qint64> added = tasksDB->addNewTask(
+        username, task.name, task.desc, TasksDB::fromEpoch(task.deadline),
+        task.reminder, created);
+    int load = generation;
+    whenFinished(added, this, [=](qint64 id) {
+        // a task added before a reload is part of the reloaded tasks
+        if (id < 0 || load != generation)
+            return;
+        Task stored = task;
+        stored.id = id;
+        stored.snoozed = TasksDB::NOTSNOOZED;
+        stored.snoozeTime = 0;
+        insert(stored);
+        emit taskAdded(id);
+    });
+    return added;
+}
+
+void TaskStore::updateTask(const Task &task)
+{
+    if (!tasks.contains(task.id))
+        return;
+    Task updated = task;
+    updated.snoozed = tasks.value(task.id).snoozed;
+    updated.snoozeTime = tasks.value(task.id).snoozeTime;
+    replace(updated);
+    tasksDB->updateTask(username, task.id, task.name, task.desc,
+                        TasksDB::fromEpoch(task.deadline), task.reminder);
+    emit taskChanged(task.id);
+}
+
+void TaskStore::removeTask(qint64 id)
+{
+    auto it = tasks.find(id);
+    if (it == tasks.end())
+        return;
+    untrack(*it);
+    tasks.erase(it);
+    tasksDB->deleteTask(username, id);
+    emit taskRemoved(id);
+}
+
+void TaskStore::fetchTasks(qint64 firstId, int count)
+{
+    int load = generation;
+    whenFinished(tasksDB->getTasks(username, firstId - 1, count), this,
+                 [=](const Tasks &stored) {
+        if (load != generation)
+            return;
+        QVector<qint64> added;
+        added.reserve(stored.size());
+        for (const Task &task : stored) {
+            if (!tasks.contains(task.id)) {
+                insert(task);
+                added.append(task.id);
+            }
+        }
+        if (!added.isEmpty())
+            emit tasksAdded(added);
+    });
+}
+
+void TaskStore::dismissReminder(qint64 id)
+{
+    if (!tasks.contains(id))
+        return;
+    Task task = tasks.value(id);
+    task.reminder = TasksDB::NOREMINDER;
+    task.snoozed = TasksDB::NOTSNOOZED;
+    task.snoozeTime = 0;
+    replace(task);
+    tasksDB->dismissReminder(username, id);
+    emit taskChanged(id);
+}
+
+void TaskStore::snoozeTask(qint64 id, int snoozed, const QString &time)
+{
+    // a snooze replaces the reminder of the task
+    if (!tasks.contains(id))
+        return;
+    Task task = tasks.value(id);
+    task.reminder = TasksDB::NOREMINDER;
+    task.snoozed = snoozed;
+    task.snoozeTime = TasksDB::toEpoch(time);
+    replace(task);
+    tasksDB->setSnoozeForTask(username, id, snoozed, time);
+    emit taskChanged(id);
+}
+
+ReminderCheck TaskStore::checkReminders()
+{
+    // the tasks whose fire time has come (in this minute) are found
+    // in fireTimes, the overdue ones are dismissed afterwards
+    ReminderCheck check;
+    if (!loaded)
+        return check;
+    qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+    qint64 minuteEnd = currentTime / 60 * 60 + 59;
+    for (auto it = fireTimes.constBegin();
+         it != fireTimes.constEnd() && it.key() <= minuteEnd; ++it)
+        TasksDB::checkReminder(task(it.value()), it.key(), currentTime,
+                               &check);
+    for (const Reminder &reminder : check.overdue)
+        dismissReminder(reminder.id);
+    return check;
+}
+
+qint64 TaskStore::nextFireTime(qint64 after) const
+{
+    // The first fire time after the given second, or the deadline of
+    // a task whose fire time has already passed: its reminder stays
+    // until the task turns overdue a second after the deadline. A task
+    // whose fire time is still ahead fires no later than a second
+    // after its deadline, so the first deadline not yet passed of all
+    // the tasks with a fire time will do. Both are found in O(log n).
+    qint64 next = 0;
+    auto fire = fireTimes.upperBound(after);
+    if (fire != fireTimes.constEnd())
+        next = fire.key();
+    auto deadline = fireDeadlines.lowerBound(after);
+    if (deadline != fireDeadlines.constEnd() &&
+        (next == 0 || deadline.key() + 1 < next))
+        next = deadline.key() + 1;
+    return next;
+}
+
+void TaskStore::insert(const Task &task)
+{
+    tasks.insert(task.id, task);
+    track(task);
+}
+
+void TaskStore::replace(const Task &task)
+{
+    auto it = tasks.find(task.id);
+    untrack(*it);
+    *it = task;
+    track(task);
+}
+
+void TaskStore::track(const Task &task)
+{
+    qint64 fire = fireAt(task);
+    if (fire > 0) {
+        fireTimes.insert(fire, task.id);
+        fireDeadlines.insert(task.deadline, task.id);
+    }
+}
+
+void TaskStore::untrack(const Task &task)
+{
+    if (fireTimes.remove(fireAt(task), task.id) > 0)
+        fireDeadlines.remove(task.deadline, task.id);
+}
+
+qint64 TaskStore::fireAt(const Task &task)
+{
+    return TasksDB::nextFireAt(task.deadline, task.reminder, task.snoozed,
+                               task.snoozeTime);
+}
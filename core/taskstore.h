@@ -0,0 +1,100 @@
+/**
+  * This class keeps the tasks of the current user in memory.
+  * They are read from the database in pages when the user
+  * is loaded. Changes are applied in memory first and then
+  * written through to the database, whose calls are queued
+  * in order (see AsyncTasksDB), so later reads of the
+  * database see them. Every change is announced with the
+  * id of the task, the table model and the reminder
+  * scheduler follow the store through these signals.
+  *
+**/
+
+#ifndef TASKSTORE_H
+#define TASKSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QMultiMap>
+#include <QVector>
+#include <QFuture>
+#include "task.h"
+
+class AsyncTasksDB;
+
+class TaskStore : public QObject
+{
+    Q_OBJECT
+  public:
+    explicit TaskStore(AsyncTasksDB *tasksDB, QObject *parent = 0);
+
+    void clear();
+    // reads the user's tasks in the database thread, every page is
+    // announced with tasksAdded as it arrives and loadFinished is
+    // emitted after the last one
+    void load(const QString &);
+    QString user() const;
+    bool isLoaded() const;
+
+    int size() const;
+    bool contains(qint64) const;
+    // the task must be in the store
+    const Task &task(qint64) const;
+    // the ids of all tasks in (deadline, id) order like the database's
+    // deadline index
+    QVector<qint64> ids() const;
+
+    // the task is added (and taskAdded emitted) once the database has
+    // given it an id; the future holds the id, -1 on failure
+    QFuture<qint64> addTask(const Task &, const QString &);
+    // the snooze state of the stored task is kept
+    void updateTask(const Task &);
+    void removeTask(qint64);
+    // reads tasks which were stored by someone else, e.g. an import,
+    // count tasks from the given id on; tasksAdded is emitted
+    void fetchTasks(qint64, int);
+    void dismissReminder(qint64);
+    void snoozeTask(qint64, int, const QString &);
+    // see TasksDB::checkReminders, this one runs on the tasks in memory
+    ReminderCheck checkReminders();
+    // the first epoch second after the given one at which
+    // checkReminders has something new to report, 0 for never
+    qint64 nextFireTime(qint64) const;
+
+  signals:
+    void reset();
+    void taskAdded(qint64 id);
+    // tasks read from the database, e.g. a page of a load in
+    // (deadline, id) order
+    void tasksAdded(const QVector<qint64> &ids);
+    void loadFinished();
+    void taskChanged(qint64 id);
+    void taskRemoved(qint64 id);
+
+  private slots:
+    // the database lost writes which are in memory already, see
+    // AsyncTasksDB::writesLost
+    void reload();
+
+  private:
+    void loadPage(int, qint64, qint64);
+    void insert(const Task &);
+    void replace(const Task &);
+    void track(const Task &);
+    void untrack(const Task &);
+    static qint64 fireAt(const Task &);
+
+    AsyncTasksDB *tasksDB;
+    QString username;
+    bool loaded;
+    // changes on every load, results of an earlier load are dropped
+    int generation;
+    QHash<qint64, Task> tasks;
+    // the next fire time (TasksDB::nextFireAt) of every task which
+    // has one, like the Tasks_next_fire index of the database
+    QMultiMap<qint64, qint64> fireTimes;
+    // the deadlines of the tasks in fireTimes, see nextFireTime
+    QMultiMap<qint64, qint64> fireDeadlines;
+};
+
+#endif // TASKSTORE_H